@@ -0,0 +1,523 @@
+// Microbenchmarks dos caminhos quentes: flocking (World::Update), câmera
+// (World::UpdateCamera), criação do bando (World::SpawnFlock), kernel de vizinhança,
+// campo do cenário e funções de Vector3. Os resultados saem em JSON para
+// acompanhar o ns/boid/frame ao longo do tempo.
+//
+// Uso: boids_bench [--max-boids N] [--threads N] [--min-time S] [--output arquivo.json]
+
+#include "World.h"
+#include "Random.h"
+#include "NeighborKernel.h"
+#include "SceneryField.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+    std::string name;
+    std::string density;
+    size_t boids;
+    int threads;
+    long long iterations;
+    double nsPerIteration; // ns por frame (flock/câmera) ou por operação (math)
+    double nsPerItem;      // ns por boid/frame ou por vetor
+    double maxError;       // desvio máximo em relação à referência escalar (quando se aplica)
+};
+
+// Densidade do bando: vizinhos médios dentro do raio de percepção
+struct Density {
+    const char* name;
+    float neighbors;
+};
+
+static const Density kDensities[] = {
+    { "sparse", 1.0f },
+    { "medium", 8.0f },
+    { "dense", 40.0f },
+};
+
+static const size_t kFlockSizes[] = { 100, 1000, 10000, 100000, 1000000 };
+
+// Valor acumulado pelos benchmarks de math para o compilador não descartar o laço
+static volatile float gSink;
+
+// Repete fn até passar de minSeconds (e pelo menos minIterations vezes).
+// Retorna o número de iterações e o tempo total em ns.
+template <typename Fn>
+static long long RunTimed(double minSeconds, long long minIterations, Fn&& fn, double& totalNs) {
+    long long iterations = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0.0;
+    while (iterations < minIterations || elapsed < minSeconds * 1.0e9) {
+        fn();
+        iterations++;
+        elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    totalNs = elapsed;
+    return iterations;
+}
+
+// Espalha o bando num cubo cujo tamanho dá a densidade pedida
+static void ScatterFlock(World& world, const Density& density) {
+    const float r = Boid::PerceptionRadius;
+    const float sphereVolume = 4.0f / 3.0f * Math::Pi * r * r * r;
+    FlockFrame& frame = world.GetFlock().Current();
+    const size_t count = frame.positions.size();
+
+    float side = cbrtf(static_cast<float>(count) * sphereVolume / density.neighbors);
+    float half = side * 0.5f;
+    for (size_t i = 0; i < count; i++) {
+        frame.positions[i] = Random::GetVector(Vector3(-half, 40.0f, -half), Vector3(half, 40.0f + side, half));
+        frame.velocities[i] = Random::GetVector(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)) * 16.0f;
+    }
+}
+
+static void BenchFlock(size_t boidCount, int threadCount, double minSeconds, std::vector<BenchResult>& results) {
+    for (const Density& density : kDensities) {
+        World world;
+        world.SetThreadCount(threadCount);
+        world.Init(static_cast<int>(boidCount) - 1); // +1 do objetivo
+        ScatterFlock(world, density);
+
+        // Aquecimento (aloca a grade e os buffers)
+        world.Update(0.016f);
+
+        double totalNs = 0.0;
+        long long frames = RunTimed(minSeconds, 3, [&] { world.Update(0.016f); }, totalNs);
+        double nsPerFrame = totalNs / static_cast<double>(frames);
+        results.push_back({ "flock_update", density.name, boidCount, world.GetThreadCount(), frames,
+                            nsPerFrame, nsPerFrame / static_cast<double>(boidCount), 0.0 });
+
+        frames = RunTimed(minSeconds, 3, [&] { world.UpdateCamera(0.016f); }, totalNs);
+        nsPerFrame = totalNs / static_cast<double>(frames);
+        results.push_back({ "update_camera", density.name, boidCount, world.GetThreadCount(), frames,
+                            nsPerFrame, nsPerFrame / static_cast<double>(boidCount), 0.0 });
+
+        fprintf(stderr, "flock %7zu %-6s %10.1f ns/boid/frame\n",
+                boidCount, density.name, results[results.size() - 2].nsPerItem);
+    }
+}
+
+// World::SpawnFlock num mundo vazio; só a criação entra no tempo
+static void BenchSpawn(size_t boidCount, int threadCount, double minSeconds, std::vector<BenchResult>& results) {
+    struct Shape {
+        const char* name;
+        SpawnDistribution distribution;
+    };
+    const Shape shapes[] = {
+        { "box", SpawnDistribution::Box(Vector3(-200.0f, 5.0f, -200.0f), Vector3(200.0f, 60.0f, 200.0f)) },
+        { "sphere", SpawnDistribution::Sphere(Vector3(0.0f, 30.0f, 0.0f), 100.0f) },
+    };
+
+    for (const Shape& shape : shapes) {
+        long long iterations = 0;
+        double totalNs = 0.0;
+        while (iterations < 3 || totalNs < minSeconds * 1.0e9) {
+            World world;
+            world.SetThreadCount(threadCount);
+            Clock::time_point start = Clock::now();
+            world.SpawnFlock(boidCount, shape.distribution);
+            totalNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            iterations++;
+        }
+
+        double nsPerSpawn = totalNs / static_cast<double>(iterations);
+        results.push_back({ "flock_spawn", shape.name, boidCount, threadCount, iterations,
+                            nsPerSpawn, nsPerSpawn / static_cast<double>(boidCount), 0.0 });
+        fprintf(stderr, "spawn %7zu %-6s %10.2f ms (%.1f ns/boid)\n",
+                boidCount, shape.name, nsPerSpawn * 1.0e-6, results.back().nsPerItem);
+    }
+}
+
+static void BenchMath(double minSeconds, std::vector<BenchResult>& results) {
+    const size_t count = 1 << 16;
+    std::vector<Vector3> a(count);
+    std::vector<Vector3> b(count);
+    for (size_t i = 0; i < count; i++) {
+        a[i] = Random::GetVector(Vector3(-50.0f, -50.0f, -50.0f), Vector3(50.0f, 50.0f, 50.0f));
+        b[i] = Random::GetVector(Vector3(-50.0f, -50.0f, -50.0f), Vector3(50.0f, 50.0f, 50.0f));
+    }
+
+    auto record = [&](const char* name, long long iterations, double totalNs) {
+        double nsPerPass = totalNs / static_cast<double>(iterations);
+        results.push_back({ name, "", 0, 1, iterations * static_cast<long long>(count),
+                            nsPerPass / static_cast<double>(count), nsPerPass / static_cast<double>(count), 0.0 });
+        fprintf(stderr, "%-25s %10.2f ns/op\n", name, results.back().nsPerItem);
+    };
+
+    double totalNs = 0.0;
+    long long passes = RunTimed(minSeconds, 3, [&] {
+        float acc = 0.0f;
+        for (size_t i = 0; i < count; i++) {
+            acc += Vector3::Normalize(a[i]).x;
+        }
+        gSink = acc;
+    }, totalNs);
+    record("vector3_normalize", passes, totalNs);
+
+    passes = RunTimed(minSeconds, 3, [&] {
+        float acc = 0.0f;
+        for (size_t i = 0; i < count; i++) {
+            acc += Vector3::Distance(a[i], b[i]);
+        }
+        gSink = acc;
+    }, totalNs);
+    record("vector3_distance", passes, totalNs);
+
+    passes = RunTimed(minSeconds, 3, [&] {
+        float acc = 0.0f;
+        for (size_t i = 0; i < count; i++) {
+            acc += Vector3::Lerp(a[i], b[i], 0.25f).y;
+        }
+        gSink = acc;
+    }, totalNs);
+    record("vector3_lerp", passes, totalNs);
+
+    // Versão em lote (SSE2, usada no LOD) contra o laço escalar equivalente
+    std::vector<float> distSq(count);
+    passes = RunTimed(minSeconds, 3, [&] {
+        for (size_t i = 0; i < count; i++) {
+            distSq[i] = (a[i] - b[0]).LengthSq();
+        }
+        gSink = distSq[count / 2];
+    }, totalNs);
+    record("vector3_distance_sq", passes, totalNs);
+
+    passes = RunTimed(minSeconds, 3, [&] {
+        Vector3::DistanceSqArray(b[0], a.data(), distSq.data(), count);
+        gSink = distSq[count / 2];
+    }, totalNs);
+    record("vector3_distance_sq_array", passes, totalNs);
+}
+
+// Geradores: o mt19937 com uniform_real_distribution (o Random antigo) contra o
+// RandomStream por chamada e em lote
+static void BenchRandom(double minSeconds, std::vector<BenchResult>& results) {
+    const size_t count = 1 << 16;
+    std::vector<float> out(count);
+
+    auto record = [&](const char* name, long long passes, double totalNs) {
+        double nsPerOp = totalNs / static_cast<double>(passes) / static_cast<double>(count);
+        results.push_back({ name, "", 0, 1, passes * static_cast<long long>(count), nsPerOp, nsPerOp, 0.0 });
+        fprintf(stderr, "%-25s %10.2f ns/op\n", name, nsPerOp);
+    };
+
+    std::mt19937 mt(1234);
+    double totalNs = 0.0;
+    long long passes = RunTimed(minSeconds, 3, [&] {
+        for (size_t i = 0; i < count; i++) {
+            std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+            out[i] = dist(mt);
+        }
+        gSink = out[count / 2];
+    }, totalNs);
+    record("random_mt19937", passes, totalNs);
+
+    RandomStream stream(1234, 0);
+    passes = RunTimed(minSeconds, 3, [&] {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = stream.GetFloatRange(-10.0f, 10.0f);
+        }
+        gSink = out[count / 2];
+    }, totalNs);
+    record("random_float_range", passes, totalNs);
+
+    passes = RunTimed(minSeconds, 3, [&] {
+        stream.FillFloats(out.data(), count, -10.0f, 10.0f);
+        gSink = out[count / 2];
+    }, totalNs);
+    record("random_fill_floats", passes, totalNs);
+}
+
+// Math::Exact contra Math::Fast (independente de BOIDS_FAST_MATH). max_error da
+// versão rápida é o maior desvio absoluto em relação à exata (relativo no invsqrt).
+static void BenchFastMath(double minSeconds, std::vector<BenchResult>& results) {
+    const size_t count = 1 << 16;
+
+    auto bench = [&](const char* exactName, const char* fastName, float lo, float hi, bool relative,
+                     auto exact, auto fast) {
+        std::vector<float> a(count), b(count);
+        for (size_t i = 0; i < count; i++) {
+            a[i] = Random::GetFloatRange(lo, hi);
+            b[i] = Random::GetFloatRange(lo, hi);
+        }
+
+        double maxError = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            double reference = exact(a[i], b[i]);
+            double error = fabs(static_cast<double>(fast(a[i], b[i])) - reference);
+            if (relative) error /= fabs(reference);
+            maxError = Math::Max(maxError, error);
+        }
+
+        auto record = [&](const char* name, auto fn, double error) {
+            double totalNs = 0.0;
+            long long passes = RunTimed(minSeconds, 3, [&] {
+                float acc = 0.0f;
+                for (size_t i = 0; i < count; i++) {
+                    acc += fn(a[i], b[i]);
+                }
+                gSink = acc;
+            }, totalNs);
+            double nsPerOp = totalNs / static_cast<double>(passes) / static_cast<double>(count);
+            results.push_back({ name, "", 0, 1, passes * static_cast<long long>(count), nsPerOp, nsPerOp, error });
+            fprintf(stderr, "%-25s %10.2f ns/op (max error %.2e)\n", name, nsPerOp, error);
+        };
+        record(exactName, exact, 0.0);
+        record(fastName, fast, maxError);
+    };
+
+    bench("math_exact_invsqrt", "math_fast_invsqrt", 1.0e-3f, 1.0e4f, true,
+          [](float v, float) { return Math::Exact::InvSqrt(v); }, [](float v, float) { return Math::Fast::InvSqrt(v); });
+    bench("math_exact_atan2", "math_fast_atan2", -50.0f, 50.0f, false,
+          [](float y, float x) { return Math::Exact::Atan2(y, x); }, [](float y, float x) { return Math::Fast::Atan2(y, x); });
+    bench("math_exact_asin", "math_fast_asin", -1.0f, 1.0f, false,
+          [](float v, float) { return Math::Exact::Asin(v); }, [](float v, float) { return Math::Fast::Asin(v); });
+    bench("math_exact_sin", "math_fast_sin", -Math::TwoPi, Math::TwoPi, false,
+          [](float v, float) { return Math::Exact::Sin(v); }, [](float v, float) { return Math::Fast::Sin(v); });
+}
+
+// Kernel de vizinhança isolado, em cada implementação que a CPU suporta.
+// ns_per_item é por candidato; max_error é o maior desvio relativo das somas
+// em relação ao kernel escalar.
+static void BenchNeighborKernel(double minSeconds, std::vector<BenchResult>& results) {
+    const size_t count = 4096;
+    const int queryCount = 64;
+    const float half = 25.0f;
+
+    std::vector<float> x(count + NeighborKernel::Padding, 0.0f), y(x), z(x), vx(x), vy(x), vz(x);
+    for (size_t i = 0; i < count; i++) {
+        x[i] = Random::GetFloatRange(-half, half);
+        y[i] = Random::GetFloatRange(-half, half);
+        z[i] = Random::GetFloatRange(-half, half);
+        vx[i] = Random::GetFloatRange(-20.0f, 20.0f);
+        vy[i] = Random::GetFloatRange(-20.0f, 20.0f);
+        vz[i] = Random::GetFloatRange(-20.0f, 20.0f);
+    }
+    const NeighborArrays arrays = { x.data(), y.data(), z.data(), vx.data(), vy.data(), vz.data() };
+
+    // Faixas de tamanhos variados, como os baldes da grade
+    std::vector<NeighborRange> ranges;
+    for (uint32_t begin = 0; begin < count;) {
+        uint32_t end = begin + static_cast<uint32_t>(Random::GetIntRange(1, 40));
+        if (end > count) end = static_cast<uint32_t>(count);
+        ranges.push_back({ begin, end });
+        begin = end;
+    }
+
+    std::vector<Vector3> queries(queryCount);
+    for (auto& q : queries) {
+        q = Random::GetVector(Vector3(-half, -half, -half), Vector3(half, half, half));
+    }
+
+    auto runAll = [&](std::vector<NeighborSums>& out) {
+        for (int q = 0; q < queryCount; q++) {
+            out[q] = NeighborSums();
+            NeighborKernel::Accumulate(arrays, ranges.data(), static_cast<int>(ranges.size()), queries[q],
+                                       Boid::PerceptionRadius, 8.0f, out[q]);
+        }
+    };
+
+    const NeighborKernel::Isa original = NeighborKernel::GetIsa();
+    const NeighborKernel::Isa best = NeighborKernel::DetectIsa();
+
+    std::vector<NeighborSums> reference(queryCount);
+    NeighborKernel::SetIsa(NeighborKernel::Isa::Scalar);
+    runAll(reference);
+
+    auto relError = [](const Vector3& a, const Vector3& b) {
+        float scale = Math::Max(1.0f, a.Length());
+        return static_cast<double>((a - b).Length() / scale);
+    };
+
+    for (int isa = 0; isa <= static_cast<int>(best); isa++) {
+        NeighborKernel::SetIsa(static_cast<NeighborKernel::Isa>(isa));
+
+        std::vector<NeighborSums> sums(queryCount);
+        double totalNs = 0.0;
+        long long passes = RunTimed(minSeconds, 3, [&] { runAll(sums); }, totalNs);
+
+        double maxError = 0.0;
+        for (int q = 0; q < queryCount; q++) {
+            maxError = Math::Max(maxError, relError(reference[q].separation, sums[q].separation));
+            maxError = Math::Max(maxError, relError(reference[q].alignment, sums[q].alignment));
+            maxError = Math::Max(maxError, relError(reference[q].centerOfMass, sums[q].centerOfMass));
+            maxError = Math::Max(maxError, static_cast<double>(abs(reference[q].count - sums[q].count)));
+        }
+
+        std::string name = std::string("neighbor_kernel_") + NeighborKernel::GetIsaName(static_cast<NeighborKernel::Isa>(isa));
+        double nsPerPass = totalNs / static_cast<double>(passes);
+        results.push_back({ name, "", count, 1, passes, nsPerPass,
+                            nsPerPass / static_cast<double>(count * queryCount), maxError });
+        fprintf(stderr, "%-22s %6.3f ns/candidate (max error %.2e)\n", name.c_str(), results.back().nsPerItem, maxError);
+    }
+
+    NeighborKernel::SetIsa(original);
+}
+
+// Desvio do cenário: cálculo analítico (BVH + ramos) contra o campo pré-calculado,
+// numa cena esparsa e numa densa (zonas de desvio se sobrepondo).
+// max_error é a maior diferença absoluta da força (já com os pesos) entre os dois
+// fora das esferas; retorna false se o percentil 99 dela passar de
+// SceneryField::MaxInterpolationError.
+static bool BenchScenery(double minSeconds, std::vector<BenchResult>& results) {
+    struct Scene {
+        const char* name;
+        size_t obstacleCount;
+    };
+    const Scene scenes[] = { { "sparse", 50 }, { "dense", 1000 } };
+    const size_t queryCount = 1 << 14;
+    bool ok = true;
+
+    for (const Scene& scene : scenes) {
+        std::vector<Obstacle> obstacles(scene.obstacleCount);
+        for (Obstacle& obs : obstacles) {
+            obs.position = Random::GetVector(Vector3(-100.0f, 5.0f, -100.0f), Vector3(100.0f, 50.0f, 100.0f));
+            obs.radius = Random::GetFloatRange(2.0f, 8.0f);
+        }
+
+        ThreadPool threadPool;
+        ObstacleBVH bvh;
+        bvh.Build(obstacles, Boid::ObstacleMargin);
+        SceneryField field;
+        field.Bake(obstacles, bvh, threadPool);
+
+        std::vector<Vector3> queries(queryCount);
+        for (Vector3& q : queries) {
+            q = Random::GetVector(Vector3(-110.0f, 0.0f, -110.0f), Vector3(110.0f, 60.0f, 110.0f));
+        }
+
+        // Erro só fora dos sólidos: lá dentro o gradiente gira em torno do centro
+        std::vector<float> errors;
+        for (const Vector3& q : queries) {
+            bool inside = false;
+            for (const Obstacle& obs : obstacles) {
+                inside |= (q - obs.position).LengthSq() < obs.radius * obs.radius;
+            }
+            if (!inside) {
+                errors.push_back((field.SampleForce(q) - SceneryField::EvaluateForce(q, bvh)).Length());
+            }
+        }
+        std::sort(errors.begin(), errors.end());
+        double maxError = errors.back();
+        double p99Error = errors[errors.size() * 99 / 100];
+
+        auto record = [&](const char* name, long long passes, double totalNs, double error) {
+            double nsPerPass = totalNs / static_cast<double>(passes);
+            results.push_back({ name, scene.name, 0, 1, passes * static_cast<long long>(queryCount), nsPerPass,
+                                nsPerPass / static_cast<double>(queryCount), error });
+            fprintf(stderr, "%-17s %-6s %10.2f ns/query (max error %.2e)\n", name, scene.name, results.back().nsPerItem, error);
+        };
+
+        double totalNs = 0.0;
+        long long passes = RunTimed(minSeconds, 3, [&] {
+            float acc = 0.0f;
+            for (const Vector3& q : queries) {
+                acc += SceneryField::EvaluateForce(q, bvh).y;
+            }
+            gSink = acc;
+        }, totalNs);
+        record("scenery_analytic", passes, totalNs, 0.0);
+
+        passes = RunTimed(minSeconds, 3, [&] {
+            float acc = 0.0f;
+            for (const Vector3& q : queries) {
+                acc += field.SampleForce(q).y;
+            }
+            gSink = acc;
+        }, totalNs);
+        record("scenery_field", passes, totalNs, maxError);
+
+        fprintf(stderr, "scenery_field     %-6s erro p99 %.2e, %zu nós (célula %.2f)\n", scene.name,
+                p99Error, field.GetNodeCount(), field.GetCellSize());
+        if (p99Error > SceneryField::MaxInterpolationError) {
+            fprintf(stderr, "ERRO: scenery_field %s passou do limite de %.2f\n", scene.name, SceneryField::MaxInterpolationError);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static void WriteJson(FILE* out, const std::vector<BenchResult>& results) {
+    fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"density\": \"%s\", \"boids\": %zu, \"threads\": %d, "
+                     "\"iterations\": %lld, \"ns_per_iteration\": %.3f, \"ns_per_item\": %.3f, \"max_error\": %.3g}%s\n",
+                r.name.c_str(), r.density.c_str(), r.boids, r.threads,
+                r.iterations, r.nsPerIteration, r.nsPerItem, r.maxError, (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+static void PrintUsage(const char* program) {
+    printf("Uso: %s [--max-boids N] [--threads N] [--min-time S] [--output arquivo.json]\n", program);
+    printf("  --max-boids N  maior bando medido (padrão 1000000)\n");
+    printf("  --threads N    threads do Update (padrão 1, para medir o custo por boid)\n");
+    printf("  --min-time S   tempo mínimo por medição em segundos (padrão 0.5)\n");
+    printf("  --output F     grava o JSON em F em vez da saída padrão\n");
+}
+
+int main(int argc, char** argv) {
+    size_t maxBoids = 1000000;
+    int threadCount = 1;
+    double minSeconds = 0.5;
+    const char* outputPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--max-boids") == 0 && hasValue) {
+            maxBoids = static_cast<size_t>(atoll(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threadCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--min-time") == 0 && hasValue) {
+            minSeconds = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--output") == 0 && hasValue) {
+            outputPath = argv[++i];
+        }
+        else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+
+    Random::Init();
+    BenchMath(minSeconds, results);
+    BenchFastMath(minSeconds, results);
+    BenchRandom(minSeconds, results);
+    BenchNeighborKernel(minSeconds, results);
+    bool sceneryOk = BenchScenery(minSeconds, results);
+    BenchSpawn(maxBoids, threadCount, minSeconds, results);
+
+    for (size_t boidCount : kFlockSizes) {
+        if (boidCount > maxBoids) break;
+        BenchFlock(boidCount, threadCount, minSeconds, results);
+    }
+
+    FILE* out = stdout;
+    if (outputPath) {
+        out = fopen(outputPath, "w");
+        if (!out) {
+            fprintf(stderr, "Não foi possível abrir %s\n", outputPath);
+            return 1;
+        }
+    }
+    WriteJson(out, results);
+    if (out != stdout) fclose(out);
+
+    return sceneryOk ? 0 : 1;
+}
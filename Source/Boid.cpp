@@ -1,5 +1,4 @@
 #include "Boid.h"
-#include <GL/glut.h>
 #include "Random.h"
 #include "World.h"
 #include <vector>
@@ -7,34 +6,68 @@
 
 Boid::Boid(World* world)
     :mWorld(world)
-    ,mYaw(0.0f)
-    ,mPitch(0.0f)
-    ,mSpeed(0.0f)
-	,mMaxSpeed(20.0f)
+    ,mFlock(&world->GetFlock())
+    ,mIndex(0)
 {
+    mIndex = mWorld->AddBoid(this);
+    FlockState& flock = *mFlock;
+    FlockFrame& frame = flock.Current();
+
+    flock.maxSpeeds[mIndex] = 20.0f;
+
     // Inicialização aleatória para dar variedade ao bando inicial
-    mPosition = Vector3(Random::GetFloatRange(-10.0f, 10.0f), Random::GetFloatRange(25.0f, 35.0f), Random::GetFloatRange(-10.0f, 10.0f));
-	mYaw = Random::GetFloatRange(0.0f, 360.0f);
-    mPrevYaw = mYaw;
-	mPitch = Random::GetFloatRange(-20.0f, 20.0f);
-    mRoll = 0.0f;
-    mColor = Vector3(0.9f, 0.9f, 0.3f); // Cor padrão azulada para o bando
+    frame.positions[mIndex] = Random::GetVector(Vector3(-10.0f, 25.0f, -10.0f), Vector3(10.0f, 35.0f, 10.0f));
+	frame.yaws[mIndex] = Random::GetFloatRange(0.0f, 360.0f);
+    frame.prevYaws[mIndex] = frame.yaws[mIndex];
+	frame.pitches[mIndex] = Random::GetFloatRange(-20.0f, 20.0f);
+    frame.rolls[mIndex] = 0.0f;
+    flock.colors[mIndex] = Vector3(0.9f, 0.9f, 0.3f); // Cor padrão azulada para o bando
 
     // Se este boid for criado e já houver um objetivo, define uma velocidade inicial
-    if (mWorld->GetGoal() && this != mWorld->GetGoal()) {
-        mSpeed = mMaxSpeed * 0.8f;
+    size_t goalSlot = mWorld->GetGoalSlot();
+    if (goalSlot != World::NoSlot && goalSlot != mIndex) {
+        frame.speeds[mIndex] = flock.maxSpeeds[mIndex] * 0.8f;
     }
 
     // Inicializa animação dessincronizada [cite: 26, 27]
-    mAnimPhase = Random::GetFloatRange(0.0f, Math::TwoPi);
-    mFlapSpeed = Random::GetFloatRange(12.0f, 20.0f); 
+    frame.animPhases[mIndex] = Random::GetFloatRange(0.0f, Math::TwoPi);
+    flock.flapSpeeds[mIndex] = Random::GetFloatRange(12.0f, 20.0f); 
 
-    mWorld->AddBoid(this);
+    // Estado "anterior" igual ao atual, para a interpolação do desenho não partir do zero
+    flock.Next().CopySlot(frame, mIndex);
+}
+
+Boid::Boid(World* world, size_t index)
+    :mWorld(world)
+    ,mFlock(&world->GetFlock())
+    ,mIndex(index)
+{
+    mFlock->boids[mIndex] = this;
 }
 
 void Boid::Update(float deltaTime) {
+    UpdateSlot(*mWorld, mIndex, deltaTime);
+}
+
+void Boid::UpdateSlot(World& world, size_t index, float deltaTime) {
+    // Lê o estado do frame anterior; o resultado vai só para o slot deste boid em Next()
+    FlockState& flock = world.GetFlock();
+    const FlockFrame& in = flock.Current();
+    FlockFrame& out = flock.Next();
+
+    Vector3 position = in.positions[index];
+    Vector3 velocity = in.velocities[index];
+    float yaw = in.yaws[index];
+    float prevYaw = in.prevYaws[index];
+    float pitch = in.pitches[index];
+    float roll = in.rolls[index];
+    float speed = in.speeds[index];
+    float maxSpeed = flock.maxSpeeds[index];
+    float animPhase = in.animPhases[index];
+    float flapSpeed = flock.flapSpeeds[index];
     
-    bool isGoal = (this == mWorld->GetGoal());
+    const size_t goalSlot = world.GetGoalSlot();
+    bool isGoal = (index == goalSlot);
 
     // --- LÓGICA DE FLOCKING (Bando) ---
     if (!isGoal) {
@@ -42,198 +75,130 @@ void Boid::Update(float deltaTime) {
         const float alignmentWeight = 1.0f;
         const float cohesionWeight = 0.8f;
         const float goalWeight = 1.2f; 
-        const float obstacleWeight = 5.0f; // Peso alto para evitar colisão a todo custo
-        const float floorWeight = 8.0f; // Peso ALTO para evitar o chão
-        const float towerWeight = 10.0f; // Peso ALTO para evitar a torre
 
-        const float perceptionRadius = 20.0f;
+        const float perceptionRadius = PerceptionRadius;
         const float separationRadius = 8.0f;
 
         Vector3 separation(0,0,0);
         Vector3 alignment(0,0,0);
         Vector3 cohesion(0,0,0);
         Vector3 goalForce(0,0,0);
-        Vector3 obstacleForce(0,0,0); // Força de evitar obstáculos
-        Vector3 floorForce(0, 0, 0); // Força para evitar o chão
-        Vector3 towerForce(0, 0, 0);// Força para evitar a torre
 
         Vector3 centerOfMass(0,0,0);
         int neighborCount = 0;
 
-        std::vector<Boid*> boids = mWorld->GetBoids();
-        Boid* goalBoid = mWorld->GetGoal();
+        const FlockArray<Vector3>& positions = in.positions;
 
         // 1. Interação com Vizinhos
-        for (auto other : boids) {
-            if (other == this) continue;
-            float dist = Vector3::Distance(mPosition, other->GetPosition());
-
-            if (dist > 0.001f && dist < perceptionRadius) {
-                if (dist < separationRadius) {
-                    Vector3 push = mPosition - other->GetPosition();
-                    if (push.LengthSq() > 0.001f) {
-                        push.Normalize();
-                        separation += push * (1.0f / dist); 
-                    }
-                }
-                alignment += other->GetVelocity();
-                centerOfMass += other->GetPosition();
-                neighborCount++;
-            }
+        NeighborSums sums;
+        const NeighborList& neighborList = world.GetNeighborList();
+        if (neighborList.IsEnabled()) {
+            // Lista de Verlet: faixas de slots lidas direto da cópia SoA da lista
+            NeighborKernel::Accumulate(neighborList.GetArrays(), neighborList.GetRanges(index),
+                                       neighborList.GetRangeCount(index), position,
+                                       perceptionRadius, separationRadius, sums);
+        }
+        else {
+            // Só os boids das 27 células da grade ao redor podem estar dentro do raio de percepção.
+            // O kernel SIMD percorre esses candidatos direto nos arrays ordenados da grade.
+            const SpatialGrid& grid = world.GetGrid();
+            NeighborRange ranges[SpatialGrid::MaxRanges];
+            int rangeCount = grid.GatherCandidateRanges(position, ranges);
+
+            NeighborKernel::Accumulate(grid.GetSortedArrays(), ranges, rangeCount, position,
+                                       perceptionRadius, separationRadius, sums);
         }
+        separation = sums.separation;
+        alignment = sums.alignment;
+        centerOfMass = sums.centerOfMass;
+        neighborCount = sums.count;
 
         if (neighborCount > 0) {
-            if (alignment.LengthSq() > 0.001f) alignment.Normalize();
+            if (alignment.LengthSq() > 0.001f) alignment.NormalizeHot();
             
             centerOfMass *= (1.0f / static_cast<float>(neighborCount));
-            Vector3 directionToCenter = centerOfMass - mPosition;
+            Vector3 directionToCenter = centerOfMass - position;
             if (directionToCenter.LengthSq() > 0.001f) {
-                directionToCenter.Normalize();
+                directionToCenter.NormalizeHot();
                 cohesion = directionToCenter;
             }
         }
 
         // 2. Busca do Objetivo
-        if (goalBoid) {
-            Vector3 directionToGoal = goalBoid->GetPosition() - mPosition;
+        if (goalSlot != World::NoSlot) {
+            Vector3 directionToGoal = positions[goalSlot] - position;
             if (directionToGoal.LengthSq() > 0.001f) {
-                directionToGoal.Normalize();
+                directionToGoal.NormalizeHot();
                 goalForce = directionToGoal;
             }
         }
 
-        // 3. EVITAR OBSTÁCULOS (ESFERAS)
-        auto& obstacles = mWorld->GetObstacles();
-        for (const auto& obs : obstacles) {
-            float distToObs = Vector3::Distance(mPosition, obs.position);
-            
-            // Margem de segurança: Raio do obstáculo + margem pequena
-            float avoidRadius = obs.radius + 5.0f; 
-
-            if (distToObs < avoidRadius) {
-                // Vetor do centro do obstáculo para o boid
-                Vector3 push = mPosition - obs.position;
-                if (push.LengthSq() > 0.001f) {
-                    push.Normalize();
-                    // Força cresce drasticamente quando chega perto
-                    float strength = (avoidRadius - distToObs) / avoidRadius; 
-                    obstacleForce += push * strength;
-                }
-            }
-        }
-        if (obstacleForce.LengthSq() > 0.001f) obstacleForce.Normalize();
-
-        // 4. EVITAR O CHÃO
-        // Se estiver abaixo de Y = 15, começa a empurrar para cima
-        float floorThreshold = 15.0f;
-        if (mPosition.y < floorThreshold) {
-            float ratio = (floorThreshold - mPosition.y) / floorThreshold;
-            // Vetor para Cima (0, 1, 0)
-            // ratio * ratio cria uma curva exponencial: fraco longe, muito forte perto
-            floorForce = Vector3(0, 1, 0) * (ratio * ratio);
-        }
-
-        // 5. EVITAR TORRE (CONE)
-        // A torre está em (0,0,0), Radius Base = 3, Altura = 20 (definido no World.cpp)
-        const float tBaseRadius = 3.0f;
-        const float tHeight = 20.0f;
-        const float tMargin = 6.0f; // Margem de segurança larga
-
-        // Só se preocupa se estiver na faixa de altura da torre (com margem no topo)
-        if (mPosition.y > -5.0f && mPosition.y < (tHeight + tMargin)) {
-
-            // Distância horizontal do centro (0,0)
-            float distXZ = sqrtf(mPosition.x * mPosition.x + mPosition.z * mPosition.z);
-
-            // Calcula o raio do cone na altura atual do boid.
-            // Quanto mais alto, menor o raio.
-            // Fórmula: RaioAtual = RaioBase * (1 - Y / Altura)
-            float currentConeRadius = 0.0f;
-            if (mPosition.y < tHeight) {
-                currentConeRadius = tBaseRadius * (1.0f - (mPosition.y / tHeight));
-            }
-            // Se estiver acima da ponta (mas dentro da margem), o raio do cone é 0
-
-            // Raio de evasão = Raio Geométrico + Margem de Segurança
-            float evasionRadius = currentConeRadius + tMargin;
-
-            if (distXZ < evasionRadius) {
-                // Empurra para fora horizontalmente (afasta do eixo Y)
-                Vector3 push(mPosition.x, 0.0f, mPosition.z);
-
-                // Proteção caso esteja exatamente no centro (0,0,0)
-                if (push.LengthSq() < 0.001f) push = Vector3(1, 0, 0);
-                else push.Normalize();
-
-                // Força inversamente proporcional à distância (mais perto = mais força)
-                float strength = (evasionRadius - distXZ) / evasionRadius;
-                towerForce = push * strength;
-            }
-        }
+        // 3. EVITAR OBSTÁCULOS, CHÃO E TORRE
+        // O cenário estático foi pré-calculado num campo de distância em grade no
+        // World::Init: todo o desvio (já com os pesos) sai de uma interpolação trilinear
+        Vector3 sceneryForce = world.GetSceneryField().SampleForce(position);
 
         // Soma vetorial
         Vector3 steering = (separation * separationWeight) +
                            (alignment * alignmentWeight) +
                            (cohesion * cohesionWeight) +
                            (goalForce * goalWeight) +
-                           (obstacleForce * obstacleWeight) +
-                           (floorForce * floorWeight) +
-                           (towerForce * towerWeight);
+                           sceneryForce;
 
         // Aplica forças
         if (steering.LengthSq() > 0.001f) {
-            steering.Normalize();
-            Vector3 targetVelocity = steering * mMaxSpeed;
+            steering.NormalizeHot();
+            Vector3 targetVelocity = steering * maxSpeed;
             float turnSpeed = 5.0f * deltaTime; 
-            mVelocity = Vector3::Lerp(mVelocity, targetVelocity, turnSpeed);
+            velocity = Vector3::Lerp(velocity, targetVelocity, turnSpeed);
         }
 
         // Velocidade mínima
-        if (mVelocity.LengthSq() < 0.1f) {
-             if (mVelocity.LengthSq() < 0.0001f) mVelocity = Vector3(0,0,1);
-             Vector3 vNorm = mVelocity;
-             vNorm.Normalize();
-             mVelocity = vNorm * 2.0f;
+        if (velocity.LengthSq() < 0.1f) {
+             if (velocity.LengthSq() < 0.0001f) velocity = Vector3(0,0,1);
+             Vector3 vNorm = velocity;
+             vNorm.NormalizeHot();
+             velocity = vNorm * 2.0f;
         }
         
-        mPosition += mVelocity * deltaTime;
+        position += velocity * deltaTime;
 
         // Atualiza Yaw/Pitch
-        if (mVelocity.LengthSq() > 0.001f) {
-            Vector3 dir = mVelocity;
-            dir.Normalize();
-            mYaw = Math::ToDegrees(atan2f(dir.x, dir.z));
-            mPitch = Math::ToDegrees(asinf(Math::Clamp(dir.y, -1.0f, 1.0f)));
+        if (velocity.LengthSq() > 0.001f) {
+            Vector3 dir = velocity;
+            dir.NormalizeHot();
+            yaw = Math::ToDegrees(Math::Hot::Atan2(dir.x, dir.z));
+            pitch = Math::ToDegrees(Math::Hot::Asin(Math::Clamp(dir.y, -1.0f, 1.0f)));
         }
         
-        mSpeed = mVelocity.Length();
+        speed = velocity.Length();
     }
     // --- LÓGICA DO LÍDER (Objetivo) ---
     else {
         // Líder ignora obstáculos e voa baseado em input
-        float yawRad = Math::ToRadians(mYaw);
-        float pitchRad = Math::ToRadians(mPitch);
+        float yawRad = Math::ToRadians(yaw);
+        float pitchRad = Math::ToRadians(pitch);
         Vector3 forward(cosf(pitchRad) * sinf(yawRad), sinf(pitchRad), cosf(pitchRad) * cosf(yawRad));
         if (forward.LengthSq() > 0.001f) forward.Normalize();
-        mVelocity = forward * mSpeed;
-        mPosition += mVelocity * deltaTime;
+        velocity = forward * speed;
+        position += velocity * deltaTime;
     }
 
     // --- LIMITE RÍGIDO DO CHÃO (Para todos, inclusive o Líder) ---
     // Impede fisicamente de passar de Y = 2.0 (altura segura para não cortar a asa)
-    if (mPosition.y < 2.0f) {
-        mPosition.y = 2.0f;
+    if (position.y < 2.0f) {
+        position.y = 2.0f;
 
         // Se estiver apontando para baixo, zera a velocidade vertical e corrige o pitch
-        if (mVelocity.y < 0) {
-            mVelocity.y = 0;
+        if (velocity.y < 0) {
+            velocity.y = 0;
             // Força o boid a olhar para frente/cima levemente para sair do chão
-            if (mPitch < 0) mPitch = 0;
+            if (pitch < 0) pitch = 0;
         }
     }
 
     // --- ANIMAÇÃO E BANKING ---
-    float yawDiff = mYaw - mPrevYaw;
+    float yawDiff = yaw - prevYaw;
     if (yawDiff > 180.0f) yawDiff -= 360.0f;
     if (yawDiff < -180.0f) yawDiff += 360.0f;
 
@@ -241,180 +206,32 @@ void Boid::Update(float deltaTime) {
     targetRoll = Math::Clamp(targetRoll, -90.0f, 90.0f);
 
     float bankSpeed = (fabs(yawDiff) < 0.1f) ? 2.0f : 5.0f;
-    mRoll += (targetRoll - mRoll) * bankSpeed * deltaTime;
-
-    float flapFactor = 1.0f + (mSpeed / mMaxSpeed); 
-    mAnimPhase += (mFlapSpeed * flapFactor) * deltaTime;
-    if (mAnimPhase > Math::TwoPi) mAnimPhase -= Math::TwoPi;
-
-    mPrevYaw = mYaw;
-}
-
-Vector3 Boid::CalculateNormal(Vector3 v1, Vector3 v2, Vector3 v3) {
-    Vector3 edge1 = v2 - v1;
-    Vector3 edge2 = v3 - v1;
-    Vector3 normal = Vector3::Cross(edge1, edge2);
-    
-    // PROTEÇÃO: Se o triângulo for degenerado (área zero), retorna Up vector padrão
-    if (normal.LengthSq() > 0.0001f) {
-        normal.Normalize();
-    } else {
-        return Vector3(0, 1, 0); 
-    }
-    return normal;
-}
-
-void Boid::DrawBirdModel(float wingOffset, bool isShadow) {
-    const float s = 0.5f;
-
-    // Vértices fixos do corpo
-    Vector3 vTip(0.0f * s, 0.0f * s, 2.5f * s);
-    Vector3 vBeakBase(0.0f * s, 0.3f * s, 1.5f * s);
-    Vector3 vNeck(0.0f * s, 0.5f * s, 0.5f * s);
-    Vector3 vTailTip(0.0f * s, 0.2f * s, -1.5f * s);
-    Vector3 vBelly(0.0f * s, -0.3f * s, 0.0f * s);
-    Vector3 vBodySideR(0.4f * s, 0.0f * s, 0.5f * s);
-    Vector3 vBodySideL(-0.4f * s, 0.0f * s, 0.5f * s);
-
-    // --- APLICANDO A ANIMAÇÃO NAS ASAS ---
-    Vector3 vWingR(2.5f * s, 0.2f * s + wingOffset, -0.5f * s);
-    Vector3 vWingL(-2.5f * s, 0.2f * s + wingOffset, -0.5f * s);
-
-    Vector3 normal;
-
-    glBegin(GL_TRIANGLES);
-
-    // --- BICO ---
-    if (!isShadow) {
-        glColor3f(0.8f, 0.1f, 0.1f);
-    }
-
-    // Bico Superior Dir
-    normal = CalculateNormal(vTip, vBodySideR, vBeakBase);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vTip.x, vTip.y, vTip.z);
-    glVertex3f(vBodySideR.x, vBodySideR.y, vBodySideR.z);
-    glVertex3f(vBeakBase.x, vBeakBase.y, vBeakBase.z);
-
-    // Bico Superior Esq
-    normal = CalculateNormal(vTip, vBeakBase, vBodySideL);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vTip.x, vTip.y, vTip.z);
-    glVertex3f(vBeakBase.x, vBeakBase.y, vBeakBase.z);
-    glVertex3f(vBodySideL.x, vBodySideL.y, vBodySideL.z);
-
-    // Bico Inferior Dir
-    normal = CalculateNormal(vTip, vBelly, vBodySideR);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vTip.x, vTip.y, vTip.z);
-    glVertex3f(vBelly.x, vBelly.y, vBelly.z);
-    glVertex3f(vBodySideR.x, vBodySideR.y, vBodySideR.z);
-
-    // Bico Inferior Esq
-    normal = CalculateNormal(vTip, vBodySideL, vBelly);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vTip.x, vTip.y, vTip.z);
-    glVertex3f(vBodySideL.x, vBodySideL.y, vBodySideL.z);
-    glVertex3f(vBelly.x, vBelly.y, vBelly.z);
-
-    // --- CORPO ---
-    if (!isShadow) {
-        glColor3f(mColor.x, mColor.y, mColor.z);
-    }
-
-    // Costas
-    normal = CalculateNormal(vNeck, vBodySideR, vTailTip);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vNeck.x, vNeck.y, vNeck.z);
-    glVertex3f(vBodySideR.x, vBodySideR.y, vBodySideR.z);
-    glVertex3f(vTailTip.x, vTailTip.y, vTailTip.z);
-
-    normal = CalculateNormal(vNeck, vTailTip, vBodySideL);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vNeck.x, vNeck.y, vNeck.z);
-    glVertex3f(vTailTip.x, vTailTip.y, vTailTip.z);
-    glVertex3f(vBodySideL.x, vBodySideL.y, vBodySideL.z);
-
-    // Conexões Pescoço
-    normal = CalculateNormal(vBeakBase, vNeck, vBodySideR);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vBeakBase.x, vBeakBase.y, vBeakBase.z);
-    glVertex3f(vNeck.x, vNeck.y, vNeck.z);
-    glVertex3f(vBodySideR.x, vBodySideR.y, vBodySideR.z);
-
-    normal = CalculateNormal(vBeakBase, vBodySideL, vNeck);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vBeakBase.x, vBeakBase.y, vBeakBase.z);
-    glVertex3f(vBodySideL.x, vBodySideL.y, vBodySideL.z);
-    glVertex3f(vNeck.x, vNeck.y, vNeck.z);
-
-    // Barriga
-    normal = CalculateNormal(vBelly, vTailTip, vBodySideR);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vBelly.x, vBelly.y, vBelly.z);
-    glVertex3f(vTailTip.x, vTailTip.y, vTailTip.z);
-    glVertex3f(vBodySideR.x, vBodySideR.y, vBodySideR.z);
-
-    normal = CalculateNormal(vBelly, vBodySideL, vTailTip);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vBelly.x, vBelly.y, vBelly.z);
-    glVertex3f(vBodySideL.x, vBodySideL.y, vBodySideL.z);
-    glVertex3f(vTailTip.x, vTailTip.y, vTailTip.z);
-
-    // --- ASAS (Vértices recalculados dinamicamente) ---
-
-    // Asa Direita Cima
-    normal = CalculateNormal(vBodySideR, vWingR, vNeck);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vBodySideR.x, vBodySideR.y, vBodySideR.z);
-    glVertex3f(vWingR.x, vWingR.y, vWingR.z);
-    glVertex3f(vNeck.x, vNeck.y, vNeck.z);
-
-    // Asa Direita Baixo
-    normal = CalculateNormal(vBodySideR, vBelly, vWingR);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vBodySideR.x, vBodySideR.y, vBodySideR.z);
-    glVertex3f(vBelly.x, vBelly.y, vBelly.z);
-    glVertex3f(vWingR.x, vWingR.y, vWingR.z);
-
-    // Asa Esquerda Cima
-    normal = CalculateNormal(vBodySideL, vNeck, vWingL);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vBodySideL.x, vBodySideL.y, vBodySideL.z);
-    glVertex3f(vNeck.x, vNeck.y, vNeck.z);
-    glVertex3f(vWingL.x, vWingL.y, vWingL.z);
-
-    // Asa Esquerda Baixo
-    normal = CalculateNormal(vBodySideL, vWingL, vBelly);
-    glNormal3f(normal.x, normal.y, normal.z);
-    glVertex3f(vBodySideL.x, vBodySideL.y, vBodySideL.z);
-    glVertex3f(vWingL.x, vWingL.y, vWingL.z);
-    glVertex3f(vBelly.x, vBelly.y, vBelly.z);
-
-    glEnd();
-}
-
-
-void Boid::Draw(bool isShadow) {
-     glPushMatrix();
-     glTranslatef(mPosition.x, mPosition.y, mPosition.z);
-
-     // Aplica as rotações baseadas no movimento calculado no Update
-     glRotatef(mYaw, 0.0f, 1.0f, 0.0f);   // Direção horizontal [cite: 39]
-     glRotatef(-mPitch, 1.0f, 0.0f, 0.0f);// Direção vertical (inverso no OpenGL) [cite: 38]
-     glRotatef(mRoll, 0.0f, 0.0f, 1.0f);  // Inclinação nas curvas [cite: 40]
-
-     // --- CÁLCULO DA ANIMAÇÃO DA ASA ---
-    // sin(mAnimPhase) vai de -1 a 1. 
-    // Multiplicamos por 0.5f para definir a amplitude (altura) da batida.
-     float wingOffset = sinf(mAnimPhase) * 0.5f;
-
-     DrawBirdModel(wingOffset, isShadow);
-
-     glPopMatrix();
+    roll += (targetRoll - roll) * bankSpeed * deltaTime;
+
+    float flapFactor = 1.0f + (speed / maxSpeed); 
+    animPhase += (flapSpeed * flapFactor) * deltaTime;
+    if (animPhase > Math::TwoPi) animPhase -= Math::TwoPi;
+
+    prevYaw = yaw;
+
+    out.positions[index] = position;
+    out.velocities[index] = velocity;
+    out.yaws[index] = yaw;
+    out.prevYaws[index] = prevYaw;
+    out.pitches[index] = pitch;
+    out.rolls[index] = roll;
+    out.speeds[index] = speed;
+    out.animPhases[index] = animPhase;
 }
 
 void Boid::HandleKey(std::map<unsigned char, bool> keyStates, std::map<unsigned char, bool> prevKeyStates) {
+    // Input chega entre os passos, então altera o estado atual
+    FlockFrame& frame = mFlock->Current();
+    float& yaw = frame.yaws[mIndex];
+    float& pitch = frame.pitches[mIndex];
+    float& speed = frame.speeds[mIndex];
+    float maxSpeed = mFlock->maxSpeeds[mIndex];
+
     // Apenas o boid objetivo deve processar inputs diretamente
     
     const float rotSpeed = 3.0f;   // graus por tecla
@@ -422,38 +239,38 @@ void Boid::HandleKey(std::map<unsigned char, bool> keyStates, std::map<unsigned
 
     // Rotação horizontal (Yaw)
     if (keyStates['a']) {
-        mYaw += rotSpeed;
+        yaw += rotSpeed;
     }
     if (keyStates['d']) {
-        mYaw -= rotSpeed;
+        yaw -= rotSpeed;
     }
 
     // Rotação vertical (Pitch)
     if (keyStates['i']) {          // subir
-        mPitch += rotSpeed;
-        if (mPitch > 89.0f) mPitch = 89.0f; // evita travar no topo
+        pitch += rotSpeed;
+        if (pitch > 89.0f) pitch = 89.0f; // evita travar no topo
     }
     if (keyStates['k']) {          // descer
-        mPitch -= rotSpeed;
-        if (mPitch < -89.0f) mPitch = -89.0f;
+        pitch -= rotSpeed;
+        if (pitch < -89.0f) pitch = -89.0f;
     }
 
     // Controle de velocidade
     if (keyStates['w']) {
-        mSpeed += accel;
-        if (mSpeed > mMaxSpeed) {
-            mSpeed = mMaxSpeed;
+        speed += accel;
+        if (speed > maxSpeed) {
+            speed = maxSpeed;
         }
     }
     if (keyStates['s']) {
-        mSpeed -= accel;
-        if (mSpeed < 0.0f) {
-            mSpeed = 0.0f;
+        speed -= accel;
+        if (speed < 0.0f) {
+            speed = 0.0f;
         }
     }
 
     // Parar
     if (keyStates[' ']) {
-        mSpeed = 0.0f;
+        speed = 0.0f;
     }
 }
\ No newline at end of file
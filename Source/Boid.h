@@ -1,43 +1,54 @@
 #pragma once
 #include "Math.h"
+#include "FlockState.h"
 #include <map>
 
+// O estado do boid mora nos arrays do FlockState do World;
+// o Boid guarda só o índice do seu slot.
 class Boid {
 public:
+    // Raio em que um boid enxerga os vizinhos (também é o tamanho da célula da grade espacial)
+    static constexpr float PerceptionRadius = 20.0f;
+
+    // Margem de segurança em volta dos obstáculos (raio + margem = zona de desvio)
+    static constexpr float ObstacleMargin = 5.0f;
+
     Boid(class World* world);
 
-    virtual void Update(float deltaTime);
-    void Draw(bool isShadow = false);
+    // Liga o boid a um slot já preenchido do FlockState (World::GetBoid, slots de snapshot)
+    Boid(class World* world, size_t index);
 
-    Vector3 GetPosition() { return mPosition; }
-    void SetPosition(Vector3 pos) { mPosition = pos; }
+    void Update(float deltaTime);
+    void Draw(float alpha, bool isShadow = false);
 
-    Vector3 GetVelocity() { return mVelocity; }
-    void SetVelocity(Vector3 velocity) { mVelocity = velocity; }
+    // O mesmo passo e o mesmo desenho direto pelo slot, sem objeto Boid. Os
+    // laços do World usam estes: slots vindos de snapshot não têm Boid.
+    static void UpdateSlot(class World& world, size_t index, float deltaTime);
+    static void DrawSlot(const class World& world, size_t index, float alpha, bool isShadow = false);
 
-    void SetColor(Vector3 color) { mColor = color; }
+    Vector3 GetPosition() const { return mFlock->Current().positions[mIndex]; }
+    void SetPosition(Vector3 pos) { mFlock->Current().positions[mIndex] = pos; }
 
-    void HandleKey(std::map<unsigned char, bool> keyStates, std::map<unsigned char, bool> prevKeyStates);
+    Vector3 GetVelocity() const { return mFlock->Current().velocities[mIndex]; }
+    void SetVelocity(Vector3 velocity) { mFlock->Current().velocities[mIndex] = velocity; }
 
-protected:
-	Vector3 CalculateNormal(Vector3 v1, Vector3 v2, Vector3 v3);
-	void DrawBirdModel(float wingOffset, bool isShadow);
+    void SetColor(Vector3 color) { mFlock->colors[mIndex] = color; }
 
+    // Slot do boid no FlockState (muda quando o World reorganiza o bando)
+    size_t GetIndex() const { return mIndex; }
+    void SetIndex(size_t index) { mIndex = index; }
 
-    class World* mWorld;
+    void HandleKey(std::map<unsigned char, bool> keyStates, std::map<unsigned char, bool> prevKeyStates);
+
+    // Normal unitária do triângulo (Up se ele for degenerado); usada ao montar a malha
+    static Vector3 CalculateNormal(Vector3 v1, Vector3 v2, Vector3 v3);
 
-    Vector3 mPosition;
-    Vector3 mVelocity;
-    Vector3 mColor;
+protected:
+	// wingFrame: fase da batida de asa tabelada (ver BoidDraw.cpp)
+	static void DrawBirdModel(const Vector3& color, int wingFrame, bool isShadow);
 
-    float mYaw;      // ângulo de rotação em torno do eixo Y
-    float mPrevYaw;
-    float mPitch;
-    float mRoll;
-    float mSpeed;    // velocidade atual
-	float mMaxSpeed; // velocidade máxima
 
-    // Variáveis de Animação
-    float mAnimPhase; // Posição atual no ciclo da animação (0 a 2*PI)
-    float mFlapSpeed; // Velocidade da batida de asas
+    class World* mWorld;
+    FlockState* mFlock;
+    size_t mIndex;
 };
@@ -0,0 +1,172 @@
+// Desenho do boid em OpenGL/GLUT (fica fora do núcleo da simulação)
+
+#include "Boid.h"
+#include "World.h"
+#include <GL/glut.h>
+#include <cmath>
+
+Vector3 Boid::CalculateNormal(Vector3 v1, Vector3 v2, Vector3 v3) {
+    Vector3 edge1 = v2 - v1;
+    Vector3 edge2 = v3 - v1;
+    Vector3 normal = Vector3::Cross(edge1, edge2);
+    
+    // PROTEÇÃO: Se o triângulo for degenerado (área zero), retorna Up vector padrão
+    if (normal.LengthSq() > 0.0001f) {
+        normal.Normalize();
+    } else {
+        return Vector3(0, 1, 0); 
+    }
+    return normal;
+}
+
+// Fases da batida de asa tabeladas: o desenho usa a mais próxima da fase do boid
+static const int kWingFrameCount = 64;
+
+struct BirdTriangle {
+    Vector3 normal;
+    Vector3 vertices[3];
+};
+
+// Malha do pássaro em escala de desenho, com as normais já calculadas.
+// O corpo não muda; as asas têm uma versão para cada fase tabelada.
+struct BirdMesh {
+    static const int BeakCount = 4;  // Primeiros triângulos do corpo (cor do bico)
+    static const int BodyCount = 10;
+    static const int WingCount = 4;
+
+    BirdTriangle body[BodyCount];
+    BirdTriangle wings[kWingFrameCount][WingCount];
+};
+
+static BirdTriangle MakeTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3) {
+    return { Boid::CalculateNormal(v1, v2, v3), { v1, v2, v3 } };
+}
+
+static BirdMesh BuildBirdMesh() {
+    const float s = 0.5f;
+
+    // Vértices fixos do corpo
+    Vector3 vTip(0.0f * s, 0.0f * s, 2.5f * s);
+    Vector3 vBeakBase(0.0f * s, 0.3f * s, 1.5f * s);
+    Vector3 vNeck(0.0f * s, 0.5f * s, 0.5f * s);
+    Vector3 vTailTip(0.0f * s, 0.2f * s, -1.5f * s);
+    Vector3 vBelly(0.0f * s, -0.3f * s, 0.0f * s);
+    Vector3 vBodySideR(0.4f * s, 0.0f * s, 0.5f * s);
+    Vector3 vBodySideL(-0.4f * s, 0.0f * s, 0.5f * s);
+
+    BirdMesh mesh;
+
+    // --- BICO ---
+    mesh.body[0] = MakeTriangle(vTip, vBodySideR, vBeakBase); // Bico Superior Dir
+    mesh.body[1] = MakeTriangle(vTip, vBeakBase, vBodySideL); // Bico Superior Esq
+    mesh.body[2] = MakeTriangle(vTip, vBelly, vBodySideR);    // Bico Inferior Dir
+    mesh.body[3] = MakeTriangle(vTip, vBodySideL, vBelly);    // Bico Inferior Esq
+
+    // --- CORPO ---
+    mesh.body[4] = MakeTriangle(vNeck, vBodySideR, vTailTip); // Costas
+    mesh.body[5] = MakeTriangle(vNeck, vTailTip, vBodySideL);
+    mesh.body[6] = MakeTriangle(vBeakBase, vNeck, vBodySideR); // Conexões Pescoço
+    mesh.body[7] = MakeTriangle(vBeakBase, vBodySideL, vNeck);
+    mesh.body[8] = MakeTriangle(vBelly, vTailTip, vBodySideR); // Barriga
+    mesh.body[9] = MakeTriangle(vBelly, vBodySideL, vTailTip);
+
+    // --- ASAS (uma versão por fase da batida) ---
+    for (int f = 0; f < kWingFrameCount; f++) {
+        // sin(fase) vai de -1 a 1; 0.5f é a amplitude (altura) da batida
+        float animPhase = Math::TwoPi * static_cast<float>(f) / static_cast<float>(kWingFrameCount);
+        float wingOffset = Math::Sin(animPhase) * 0.5f;
+
+        Vector3 vWingR(2.5f * s, 0.2f * s + wingOffset, -0.5f * s);
+        Vector3 vWingL(-2.5f * s, 0.2f * s + wingOffset, -0.5f * s);
+
+        mesh.wings[f][0] = MakeTriangle(vBodySideR, vWingR, vNeck);  // Asa Direita Cima
+        mesh.wings[f][1] = MakeTriangle(vBodySideR, vBelly, vWingR); // Asa Direita Baixo
+        mesh.wings[f][2] = MakeTriangle(vBodySideL, vNeck, vWingL);  // Asa Esquerda Cima
+        mesh.wings[f][3] = MakeTriangle(vBodySideL, vWingL, vBelly); // Asa Esquerda Baixo
+    }
+
+    return mesh;
+}
+
+// Montada uma vez, no primeiro desenho
+static const BirdMesh& GetBirdMesh() {
+    static const BirdMesh mesh = BuildBirdMesh();
+    return mesh;
+}
+
+// A sombra é desenhada sem iluminação: só os vértices importam
+static void EmitTriangles(const BirdTriangle* triangles, int count, bool isShadow) {
+    for (int t = 0; t < count; t++) {
+        const BirdTriangle& triangle = triangles[t];
+        if (!isShadow) {
+            glNormal3f(triangle.normal.x, triangle.normal.y, triangle.normal.z);
+        }
+        for (const Vector3& v : triangle.vertices) {
+            glVertex3f(v.x, v.y, v.z);
+        }
+    }
+}
+
+void Boid::DrawBirdModel(const Vector3& color, int wingFrame, bool isShadow) {
+    const BirdMesh& mesh = GetBirdMesh();
+
+    glBegin(GL_TRIANGLES);
+
+    // --- BICO ---
+    if (!isShadow) {
+        glColor3f(0.8f, 0.1f, 0.1f);
+    }
+    EmitTriangles(mesh.body, BirdMesh::BeakCount, isShadow);
+
+    // --- CORPO E ASAS ---
+    if (!isShadow) {
+        glColor3f(color.x, color.y, color.z);
+    }
+    EmitTriangles(mesh.body + BirdMesh::BeakCount, BirdMesh::BodyCount - BirdMesh::BeakCount, isShadow);
+    EmitTriangles(mesh.wings[wingFrame], BirdMesh::WingCount, isShadow);
+
+    glEnd();
+}
+
+
+// Interpola ângulos pelo menor arco (period = 360 para graus, 2*PI para a fase da asa)
+static float LerpAngle(float a, float b, float f, float period) {
+    float diff = fmodf(b - a, period);
+    if (diff > period * 0.5f) diff -= period;
+    if (diff < -period * 0.5f) diff += period;
+    return a + diff * f;
+}
+
+void Boid::Draw(float alpha, bool isShadow) {
+    DrawSlot(*mWorld, mIndex, alpha, isShadow);
+}
+
+void Boid::DrawSlot(const World& world, size_t index, float alpha, bool isShadow) {
+    // Interpola entre o passo anterior e o atual (o passo fixo da simulação
+    // não coincide com os frames de desenho)
+    const FlockState& flock = world.GetFlock();
+    const FlockFrame& prev = flock.Previous();
+    const FlockFrame& frame = flock.Current();
+    Vector3 position = Vector3::Lerp(prev.positions[index], frame.positions[index], alpha);
+    float yaw = LerpAngle(prev.yaws[index], frame.yaws[index], alpha, 360.0f);
+    float pitch = Math::Lerp(prev.pitches[index], frame.pitches[index], alpha);
+    float roll = Math::Lerp(prev.rolls[index], frame.rolls[index], alpha);
+    float animPhase = LerpAngle(prev.animPhases[index], frame.animPhases[index], alpha, Math::TwoPi);
+
+     glPushMatrix();
+     glTranslatef(position.x, position.y, position.z);
+
+     // Aplica as rotações baseadas no movimento calculado no Update
+     glRotatef(yaw, 0.0f, 1.0f, 0.0f);   // Direção horizontal [cite: 39]
+     glRotatef(-pitch, 1.0f, 0.0f, 0.0f);// Direção vertical (inverso no OpenGL) [cite: 38]
+     glRotatef(roll, 0.0f, 0.0f, 1.0f);  // Inclinação nas curvas [cite: 40]
+
+     // --- FASE DA ASA ---
+    // Fase tabelada mais próxima (a interpolada pode sair um pouco de [0, 2*PI))
+     int wingFrame = static_cast<int>(floorf(animPhase * (kWingFrameCount / Math::TwoPi) + 0.5f)) % kWingFrameCount;
+     if (wingFrame < 0) wingFrame += kWingFrameCount;
+
+     DrawBirdModel(flock.colors[index], wingFrame, isShadow);
+
+     glPopMatrix();
+}
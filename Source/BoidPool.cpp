@@ -0,0 +1,50 @@
+#include "BoidPool.h"
+
+BoidPool::BoidPool()
+    :mBumpSlab(0)
+    ,mBumpOffset(0)
+    ,mFreeList(nullptr)
+    ,mLiveCount(0)
+{
+}
+
+BoidPool::Slot* BoidPool::AllocateSlot() {
+    if (mFreeList) {
+        Slot* slot = mFreeList;
+        mFreeList = slot->nextFree;
+        return slot;
+    }
+
+    if (mBumpSlab < mSlabs.size() && mBumpOffset == SlabSize) {
+        mBumpSlab++;
+        mBumpOffset = 0;
+    }
+    if (mBumpSlab == mSlabs.size()) {
+        mSlabs.emplace_back(new Slot[SlabSize]);
+    }
+    return &mSlabs[mBumpSlab][mBumpOffset++];
+}
+
+void BoidPool::Destroy(Boid* boid) {
+    if (!boid) return;
+
+    boid->~Boid();
+    Slot* slot = reinterpret_cast<Slot*>(boid);
+    slot->nextFree = mFreeList;
+    mFreeList = slot;
+    mLiveCount--;
+}
+
+void BoidPool::Reserve(size_t count) {
+    size_t slabCount = (count + SlabSize - 1) / SlabSize;
+    while (mSlabs.size() < slabCount) {
+        mSlabs.emplace_back(new Slot[SlabSize]);
+    }
+}
+
+void BoidPool::Reset() {
+    mBumpSlab = 0;
+    mBumpOffset = 0;
+    mFreeList = nullptr;
+    mLiveCount = 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Boid.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Memória dos objetos Boid em blocos contíguos (slabs) em vez de um new por boid.
+// Os boids vêm em ordem de criação, lado a lado no mesmo slab; um boid removido
+// volta para uma lista livre e é o próximo a ser reaproveitado. Create e Destroy
+// são O(1), e Reset libera todos de uma vez sem devolver os slabs ao sistema.
+class BoidPool {
+public:
+    // Boids por slab (24 bytes cada no x64: 96 KB por slab)
+    static constexpr size_t SlabSize = 4096;
+
+    BoidPool();
+
+    BoidPool(const BoidPool&) = delete;
+    BoidPool& operator=(const BoidPool&) = delete;
+
+    // Constrói um Boid num slot livre (os argumentos vão para o construtor)
+    template <typename... Args>
+    Boid* Create(Args&&... args);
+
+    // Devolve o slot do boid para a lista livre
+    void Destroy(Boid* boid);
+
+    // Garante slabs para count boids vivos sem alocar durante a criação
+    void Reserve(size_t count);
+
+    // Descarta todos os boids; os slabs continuam alocados para os próximos
+    void Reset();
+
+    size_t GetLiveCount() const { return mLiveCount; }
+    size_t GetCapacity() const { return mSlabs.size() * SlabSize; }
+
+private:
+    // Slot livre guarda o próximo da lista no lugar do Boid
+    union Slot {
+        Slot* nextFree;
+        alignas(Boid) unsigned char storage[sizeof(Boid)];
+    };
+
+    // O Reset não chama destrutores
+    static_assert(std::is_trivially_destructible<Boid>::value, "Boid precisa ser trivialmente destrutível");
+
+    Slot* AllocateSlot();
+
+    std::vector<std::unique_ptr<Slot[]>> mSlabs;
+    size_t mBumpSlab;   // Slab em uso pela alocação sequencial
+    size_t mBumpOffset; // Próximo slot nunca usado dentro dele
+    Slot* mFreeList;    // Slots devolvidos pelo Destroy
+    size_t mLiveCount;
+};
+
+template <typename... Args>
+Boid* BoidPool::Create(Args&&... args) {
+    Slot* slot = AllocateSlot();
+    mLiveCount++;
+    return new (slot->storage) Boid(std::forward<Args>(args)...);
+}
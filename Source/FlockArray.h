@@ -0,0 +1,128 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Array contíguo de um atributo do bando. Tem a parte da interface do
+// std::vector que o FlockState usa (por isso os nomes em minúsculas), e além
+// disso pode adotar memória de fora: Adopt passa a usar elementos que já estão
+// em outro lugar (as páginas de um snapshot mapeado) em vez de copiá-los.
+//
+// A memória adotada continua viva enquanto o array guardar o owner. Quando o
+// array precisa crescer além dela, ou recebe outro conteúdo maior, os elementos
+// vão para o heap como num vector e o owner é solto.
+template <typename T>
+class FlockArray {
+    static_assert(std::is_trivially_copyable<T>::value, "FlockArray copia os elementos com memcpy");
+
+public:
+    FlockArray() : mData(nullptr), mSize(0), mCapacity(0) {}
+    FlockArray(const FlockArray& other) : FlockArray() { assign(other.begin(), other.end()); }
+    FlockArray(FlockArray&& other) noexcept : FlockArray() { swap(other); }
+    ~FlockArray() { Release(); }
+
+    FlockArray& operator=(const FlockArray& other) {
+        if (this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    FlockArray& operator=(FlockArray&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+    T* data() { return mData; }
+    const T* data() const { return mData; }
+
+    T& operator[](size_t index) { return mData[index]; }
+    const T& operator[](size_t index) const { return mData[index]; }
+    T* begin() { return mData; }
+    T* end() { return mData + mSize; }
+    const T* begin() const { return mData; }
+    const T* end() const { return mData + mSize; }
+
+    void reserve(size_t count) {
+        if (count > mCapacity) Reallocate(count);
+    }
+
+    void resize(size_t count, const T& value) {
+        if (count > mCapacity) Reallocate(Grown(count));
+        for (size_t i = mSize; i < count; i++) {
+            mData[i] = value;
+        }
+        mSize = count;
+    }
+
+    void push_back(const T& value) {
+        if (mSize == mCapacity) {
+            // value pode ser um elemento deste array
+            T copy = value;
+            Reallocate(Grown(mSize + 1));
+            mData[mSize++] = copy;
+            return;
+        }
+        mData[mSize++] = value;
+    }
+
+    void pop_back() { mSize--; }
+
+    // Copia [first, last) por cima do conteúdo (na memória adotada, se couber)
+    void assign(const T* first, const T* last) {
+        size_t count = static_cast<size_t>(last - first);
+        if (count > mCapacity) {
+            mSize = 0;
+            Reallocate(count);
+        }
+        if (count > 0) memcpy(mData, first, count * sizeof(T));
+        mSize = count;
+    }
+
+    void swap(FlockArray& other) noexcept {
+        std::swap(mData, other.mData);
+        std::swap(mSize, other.mSize);
+        std::swap(mCapacity, other.mCapacity);
+        mOwner.swap(other.mOwner);
+    }
+
+    // Passa a usar os count elementos em data, sem copiar. owner mantém a
+    // memória viva enquanto o array estiver nela.
+    void Adopt(T* data, size_t count, std::shared_ptr<void> owner) {
+        Release();
+        mData = data;
+        mSize = count;
+        mCapacity = count;
+        mOwner = std::move(owner);
+    }
+
+    // Os elementos estão em memória adotada (e não no heap do array)
+    bool IsAdopted() const { return mOwner != nullptr; }
+
+private:
+    size_t Grown(size_t count) const { return count > mCapacity * 2 ? count : mCapacity * 2; }
+
+    // Move os elementos para um bloco novo do heap com a capacidade pedida
+    void Reallocate(size_t capacity) {
+        T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        if (mSize > 0) memcpy(data, mData, mSize * sizeof(T));
+        Release();
+        mData = data;
+        mCapacity = capacity;
+    }
+
+    // Devolve o bloco do heap, ou solta a memória adotada
+    void Release() {
+        if (!mOwner) ::operator delete(mData);
+        mOwner.reset();
+        mData = nullptr;
+        mCapacity = 0;
+    }
+
+    T* mData;
+    size_t mSize;
+    size_t mCapacity;
+    std::shared_ptr<void> mOwner; // Dono da memória adotada (nulo quando ela é do heap)
+};
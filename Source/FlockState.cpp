@@ -0,0 +1,209 @@
+#include "FlockState.h"
+#include "Boid.h"
+
+// Reordena um array segundo order (novo[i] = antigo[order[i]])
+template <typename Array>
+static void PermuteArray(Array& values, const std::vector<uint32_t>& order) {
+    Array sorted;
+    sorted.reserve(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        sorted.push_back(values[order[i]]);
+    }
+    values.swap(sorted);
+}
+
+void FlockFrame::Reserve(size_t count) {
+    positions.reserve(count);
+    velocities.reserve(count);
+    yaws.reserve(count);
+    prevYaws.reserve(count);
+    pitches.reserve(count);
+    rolls.reserve(count);
+    speeds.reserve(count);
+    animPhases.reserve(count);
+}
+
+void FlockFrame::Resize(size_t count) {
+    positions.resize(count, Vector3::Zero);
+    velocities.resize(count, Vector3::Zero);
+    yaws.resize(count, 0.0f);
+    prevYaws.resize(count, 0.0f);
+    pitches.resize(count, 0.0f);
+    rolls.resize(count, 0.0f);
+    speeds.resize(count, 0.0f);
+    animPhases.resize(count, 0.0f);
+}
+
+void FlockFrame::Add() {
+    positions.push_back(Vector3::Zero);
+    velocities.push_back(Vector3::Zero);
+    yaws.push_back(0.0f);
+    prevYaws.push_back(0.0f);
+    pitches.push_back(0.0f);
+    rolls.push_back(0.0f);
+    speeds.push_back(0.0f);
+    animPhases.push_back(0.0f);
+}
+
+void FlockFrame::MoveSlot(size_t from, size_t to) {
+    positions[to] = positions[from];
+    velocities[to] = velocities[from];
+    yaws[to] = yaws[from];
+    prevYaws[to] = prevYaws[from];
+    pitches[to] = pitches[from];
+    rolls[to] = rolls[from];
+    speeds[to] = speeds[from];
+    animPhases[to] = animPhases[from];
+}
+
+void FlockFrame::CopySlot(const FlockFrame& from, size_t index) {
+    positions[index] = from.positions[index];
+    velocities[index] = from.velocities[index];
+    yaws[index] = from.yaws[index];
+    prevYaws[index] = from.prevYaws[index];
+    pitches[index] = from.pitches[index];
+    rolls[index] = from.rolls[index];
+    speeds[index] = from.speeds[index];
+    animPhases[index] = from.animPhases[index];
+}
+
+void FlockFrame::PopBack() {
+    positions.pop_back();
+    velocities.pop_back();
+    yaws.pop_back();
+    prevYaws.pop_back();
+    pitches.pop_back();
+    rolls.pop_back();
+    speeds.pop_back();
+    animPhases.pop_back();
+}
+
+void FlockFrame::Permute(const std::vector<uint32_t>& order) {
+    PermuteArray(positions, order);
+    PermuteArray(velocities, order);
+    PermuteArray(yaws, order);
+    PermuteArray(prevYaws, order);
+    PermuteArray(pitches, order);
+    PermuteArray(rolls, order);
+    PermuteArray(speeds, order);
+    PermuteArray(animPhases, order);
+}
+
+void FlockState::Reserve(size_t count) {
+    frames[0].Reserve(count);
+    frames[1].Reserve(count);
+    colors.reserve(count);
+    maxSpeeds.reserve(count);
+    flapSpeeds.reserve(count);
+    lodElapsed.reserve(count);
+    ids.reserve(count);
+    boids.reserve(count);
+    handles.reserve(count);
+    handleSlots.reserve(count);
+}
+
+uint32_t FlockState::AllocateHandle(size_t index) {
+    uint32_t handle;
+    if (freeHandle != UINT32_MAX) {
+        handle = freeHandle;
+        freeHandle = handleSlots[handle].slot;
+    }
+    else {
+        handle = static_cast<uint32_t>(handleSlots.size());
+        handleSlots.push_back({ 0, 1 });
+    }
+    handleSlots[handle].slot = static_cast<uint32_t>(index);
+    return handle;
+}
+
+void FlockState::FreeHandle(uint32_t handle) {
+    // A geração nova invalida os handles já entregues para esta entrada
+    handleSlots[handle].generation++;
+    handleSlots[handle].slot = freeHandle;
+    freeHandle = handle;
+}
+
+size_t FlockState::Add(Boid* boid) {
+    size_t index = Size();
+
+    frames[0].Add();
+    frames[1].Add();
+    colors.push_back(Vector3::One);
+    maxSpeeds.push_back(0.0f);
+    flapSpeeds.push_back(0.0f);
+    lodElapsed.push_back(0.0f);
+    ids.push_back(nextId++);
+    boids.push_back(boid);
+    handles.emplace_back(AllocateHandle(index));
+
+    return index;
+}
+
+void FlockState::Resize(size_t count) {
+    frames[0].Resize(count);
+    frames[1].Resize(count);
+    colors.resize(count, Vector3::One);
+    maxSpeeds.resize(count, 0.0f);
+    flapSpeeds.resize(count, 0.0f);
+    lodElapsed.resize(count, 0.0f);
+    ids.resize(count, 0);
+    boids.resize(count, nullptr);
+
+    for (size_t i = count; i < handles.size(); i++) {
+        FreeHandle(handles[i]);
+    }
+    handles.reserve(count);
+    for (size_t i = handles.size(); i < count; i++) {
+        handles.emplace_back(AllocateHandle(i));
+    }
+    handles.resize(count);
+}
+
+void FlockState::RemoveSwap(size_t index) {
+    size_t last = Size() - 1;
+
+    if (index != last) {
+        frames[0].MoveSlot(last, index);
+        frames[1].MoveSlot(last, index);
+        colors[index] = colors[last];
+        maxSpeeds[index] = maxSpeeds[last];
+        flapSpeeds[index] = flapSpeeds[last];
+        lodElapsed[index] = lodElapsed[last];
+        ids[index] = ids[last];
+        boids[index] = boids[last];
+        if (boids[index]) boids[index]->SetIndex(index);
+    }
+
+    FreeHandle(handles[index]);
+    if (index != last) {
+        handles[index] = handles[last];
+        handleSlots[handles[index]].slot = static_cast<uint32_t>(index);
+    }
+
+    frames[0].PopBack();
+    frames[1].PopBack();
+    colors.pop_back();
+    maxSpeeds.pop_back();
+    flapSpeeds.pop_back();
+    lodElapsed.pop_back();
+    ids.pop_back();
+    boids.pop_back();
+    handles.pop_back();
+}
+
+void FlockState::Permute(const std::vector<uint32_t>& order) {
+    frames[0].Permute(order);
+    frames[1].Permute(order);
+    PermuteArray(colors, order);
+    PermuteArray(maxSpeeds, order);
+    PermuteArray(flapSpeeds, order);
+    PermuteArray(lodElapsed, order);
+    PermuteArray(ids, order);
+    PermuteArray(boids, order);
+    PermuteArray(handles, order);
+
+    for (size_t i = 0; i < boids.size(); i++) {
+        if (boids[i]) boids[i]->SetIndex(i);
+        handleSlots[handles[i]].slot = static_cast<uint32_t>(i);
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include "Math.h"
+#include "FlockArray.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Estado do boid que muda a cada passo da simulação
+struct FlockFrame {
+    FlockArray<Vector3> positions;
+    FlockArray<Vector3> velocities;
+
+    FlockArray<float> yaws;      // ângulo de rotação em torno do eixo Y
+    FlockArray<float> prevYaws;
+    FlockArray<float> pitches;
+    FlockArray<float> rolls;
+    FlockArray<float> speeds;    // velocidade atual
+    FlockArray<float> animPhases; // Posição atual no ciclo da animação (0 a 2*PI)
+
+    void Reserve(size_t count);
+    void Resize(size_t count);
+    void Add();
+    void MoveSlot(size_t from, size_t to);
+    void CopySlot(const FlockFrame& from, size_t index);
+    void PopBack();
+    void Permute(const std::vector<uint32_t>& order);
+};
+
+// Referência estável a um boid: posição no slot-map do FlockState e geração.
+// Continua apontando para o mesmo boid quando os slots são reordenados ou
+// trocados na remoção, e deixa de ser válida (IsValid) quando ele é removido.
+// O handle padrão ({0, 0}) nunca é válido: as gerações começam em 1.
+struct BoidHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    bool operator==(const BoidHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const BoidHandle& other) const { return !(*this == other); }
+};
+
+// Estado do bando em estrutura de arrays (SoA): cada atributo fica num array
+// contíguo, indexado pelo slot do boid. Os laços de flocking, câmera e desenho
+// percorrem estes arrays direto, sem passar por ponteiros de Boid.
+//
+// O estado dinâmico fica em buffer duplo: durante o passo todos os boids leem
+// Current() (o frame anterior, só leitura) e cada um escreve apenas o próprio
+// slot em Next(). SwapBuffers() troca os dois no fim do passo. Assim o resultado
+// não depende da ordem de atualização e o passo pode ser paralelizado sem locks.
+struct FlockState {
+    FlockFrame frames[2];
+    int current = 0;
+
+    // Atributos fixos de cada boid (não mudam durante o passo)
+    FlockArray<Vector3> colors;
+    FlockArray<float> maxSpeeds;  // velocidade máxima
+    FlockArray<float> flapSpeeds; // Velocidade da batida de asas
+
+    // LOD temporal: tempo acumulado desde o último Update de cada boid
+    // (escrito durante o passo, mas só no próprio slot)
+    FlockArray<float> lodElapsed;
+
+    // Identificador estável de cada boid (o slot muda com a reordenação)
+    FlockArray<uint32_t> ids;
+    uint32_t nextId = 0;
+
+    // Boid dono de cada slot. Os slots carregados de um snapshot começam sem
+    // Boid (nullptr): os laços do passo e do desenho trabalham pelo slot, e o
+    // World::GetBoid só cria o objeto quando alguém pede por ele.
+    std::vector<class Boid*> boids;
+
+    // Slot-map dos handles: handles[slot] é a entrada de cada boid em handleSlots,
+    // e a entrada guarda o slot atual (ou o próximo livre) e a geração
+    struct HandleSlot {
+        uint32_t slot;
+        uint32_t generation;
+    };
+    std::vector<uint32_t> handles;
+    std::vector<HandleSlot> handleSlots;
+    uint32_t freeHandle = UINT32_MAX; // Lista de entradas livres (encadeada por HandleSlot::slot)
+
+    FlockFrame& Current() { return frames[current]; }
+    const FlockFrame& Current() const { return frames[current]; }
+    FlockFrame& Next() { return frames[current ^ 1]; }
+    const FlockFrame& Next() const { return frames[current ^ 1]; }
+    void SwapBuffers() { current ^= 1; }
+
+    // Entre dois passos Next() ainda guarda o estado anterior a Current();
+    // o desenho interpola entre os dois
+    const FlockFrame& Previous() const { return frames[current ^ 1]; }
+
+    size_t Size() const { return boids.size(); }
+    void Reserve(size_t count);
+
+    BoidHandle GetHandle(size_t index) const { return { handles[index], handleSlots[handles[index]].generation }; }
+
+    // O(1): a entrada existe e ainda é da mesma geração
+    bool IsValid(BoidHandle handle) const {
+        return handle.index < handleSlots.size() && handleSlots[handle.index].generation == handle.generation;
+    }
+
+    // Slot atual do boid (o handle precisa ser válido)
+    size_t Resolve(BoidHandle handle) const { return handleSlots[handle.index].slot; }
+
+    // Adiciona um slot com valores padrão e retorna o índice dele
+    size_t Add(class Boid* boid);
+
+    // Redimensiona todos os arrays de uma vez (slots novos com valores padrão
+    // e sem Boid; usado para carregar snapshots, depois de os arrays adotarem o arquivo)
+    void Resize(size_t count);
+
+    // Remove o slot trocando com o último (O(1)). O boid que ocupava o
+    // último slot tem o índice atualizado e o handle dele continua válido;
+    // o handle do removido deixa de ser.
+    void RemoveSwap(size_t index);
+
+    // Reordena os slots: o slot novo i recebe o antigo order[i]. Os Boids
+    // continuam os mesmos objetos (ponteiros e handles seguem válidos), só o índice muda.
+    // Os arrays reordenados vão para o heap (e soltam a memória que tinham adotado).
+    void Permute(const std::vector<uint32_t>& order);
+
+private:
+    uint32_t AllocateHandle(size_t index);
+    void FreeHandle(uint32_t handle);
+};
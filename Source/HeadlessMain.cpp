@@ -0,0 +1,293 @@
+// Simulação sem janela: roda N frames com um bando de tamanho dado e mostra o tempo.
+// Não depende de OpenGL/GLUT, então roda nos nós de cálculo do render farm.
+//
+// Uso: boids_headless [--boids N] [--frames N] [--threads N] [--dt S] [--sort-interval N] [--verlet-skin S]
+//                      [--obstacles N] [--lod D1,D2,D3] [--seed N] [--record F | --replay F]
+//                      [--load F] [--save F] [--trajectory F] [--trace F]
+
+#include "World.h"
+#include "Recording.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static void PrintUsage(const char* program) {
+    printf("Uso: %s [--boids N] [--frames N] [--threads N] [--dt S] [--sort-interval N] [--verlet-skin S] [--obstacles N]\n"
+           "       [--lod D1,D2,D3] [--seed N] [--record F | --replay F] [--load F] [--save F]\n"
+           "       [--trajectory F] [--trace F]\n", program);
+    printf("  --boids N    tamanho do bando (padrão 1000)\n");
+    printf("  --frames N   passos de simulação (padrão 600)\n");
+    printf("  --threads N  threads do Update, 1 = serial (padrão: todos os núcleos)\n");
+    printf("  --dt S       passo de tempo em segundos (padrão 0.016)\n");
+    printf("  --sort-interval N  reordena o bando pela curva de Morton a cada N frames, 0 desliga (padrão 32)\n");
+    printf("  --verlet-skin S    usa listas de vizinhos de Verlet com margem S, 0 desliga (padrão 0)\n");
+    printf("  --obstacles N      esferas extras espalhadas pela cena, além das 3 fixas (padrão 0)\n");
+    printf("  --lod D1,D2,D3     LOD temporal: além de D1/D2/D3 da câmera atualiza a 1/2, 1/4, 1/8 (padrão desligado)\n");
+    printf("  --seed N     semente do Random (padrão: sorteada)\n");
+    printf("  --record F   grava semente, configuração e teclado de cada passo em F\n");
+    printf("  --replay F   refaz a execução gravada em F (a configuração e o número de frames vêm do arquivo)\n");
+    printf("  --load F     começa do snapshot F em vez de gerar o bando (ignora --boids/--obstacles/--seed)\n");
+    printf("  --save F     grava um snapshot do mundo em F no fim\n");
+    printf("  --trajectory F     exporta posição/velocidade de cada frame em F (CSV se terminar em .csv, senão binário)\n");
+    printf("  --trace F    grava os eventos de cada fase e thread em F (JSON do chrome://tracing)\n");
+}
+
+// Hash (FNV-1a) das posições e velocidades finais, para comparar execuções bit a bit
+static uint64_t HashFlockState(const FlockFrame& frame) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    mix(frame.positions.data(), frame.positions.size() * sizeof(Vector3));
+    mix(frame.velocities.data(), frame.velocities.size() * sizeof(Vector3));
+    return hash;
+}
+
+int main(int argc, char** argv) {
+    int boidCount = 1000;
+    int frameCount = 600;
+    int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    float deltaTime = 0.016f;
+    int sortInterval = -1;
+    float verletSkin = 0.0f;
+    int obstacleCount = 0;
+    float lodDistances[3] = { 0.0f, 0.0f, 0.0f };
+    long long seed = -1;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* loadPath = nullptr;
+    const char* savePath = nullptr;
+    const char* trajectoryPath = nullptr;
+    const char* tracePath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--boids") == 0 && hasValue) {
+            boidCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frameCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threadCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--dt") == 0 && hasValue) {
+            deltaTime = static_cast<float>(atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--sort-interval") == 0 && hasValue) {
+            sortInterval = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--verlet-skin") == 0 && hasValue) {
+            verletSkin = static_cast<float>(atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--obstacles") == 0 && hasValue) {
+            obstacleCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--lod") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%f,%f,%f", &lodDistances[0], &lodDistances[1], &lodDistances[2]) != 3) {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = atoll(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--record") == 0 && hasValue) {
+            recordPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && hasValue) {
+            replayPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--load") == 0 && hasValue) {
+            loadPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--save") == 0 && hasValue) {
+            savePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--trajectory") == 0 && hasValue) {
+            trajectoryPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && hasValue) {
+            tracePath = argv[++i];
+        }
+        else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (boidCount < 0 || frameCount < 1 || deltaTime <= 0.0f || (recordPath && replayPath) ||
+        (loadPath && (recordPath || replayPath))) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    World world;
+    world.SetThreadCount(threadCount);
+    if (sortInterval >= 0) world.SetSortInterval(sortInterval);
+    world.SetNeighborListSkin(verletSkin);
+    world.SetLodDistances(lodDistances[0], lodDistances[1], lodDistances[2]);
+    if (seed >= 0) world.SetSeed(static_cast<uint32_t>(seed));
+
+    // Reprodução: a configuração da gravação substitui a da linha de comando
+    Replayer replayer;
+    if (replayPath) {
+        if (!replayer.Open(replayPath)) {
+            fprintf(stderr, "Não foi possível ler a gravação %s\n", replayPath);
+            return 1;
+        }
+        const RecordHeader& header = replayer.GetHeader();
+        header.Apply(world);
+        boidCount = static_cast<int>(header.boidCount);
+        obstacleCount = static_cast<int>(header.extraObstacles);
+        deltaTime = header.deltaTime;
+        frameCount = static_cast<int>(replayer.GetFrameCount());
+        if (frameCount < 1) {
+            fprintf(stderr, "A gravação %s não tem nenhum passo\n", replayPath);
+            return 1;
+        }
+    }
+
+    Clock::time_point initStart = Clock::now();
+    if (loadPath) {
+        if (!world.LoadSnapshot(loadPath)) {
+            fprintf(stderr, "Não foi possível carregar o snapshot %s\n", loadPath);
+            return 1;
+        }
+    }
+    else {
+        world.Init(boidCount);
+        world.AddRandomObstacles(obstacleCount);
+    }
+    double initMs = std::chrono::duration<double, std::milli>(Clock::now() - initStart).count();
+
+    Recorder recorder;
+    if (recordPath && !recorder.Open(recordPath, RecordHeader::Capture(world, boidCount, obstacleCount, deltaTime))) {
+        fprintf(stderr, "Não foi possível abrir %s\n", recordPath);
+        return 1;
+    }
+
+    if (trajectoryPath) {
+        size_t length = strlen(trajectoryPath);
+        bool csv = length >= 4 && strcmp(trajectoryPath + length - 4, ".csv") == 0;
+        if (!world.OpenTrajectory(trajectoryPath, csv ? TrajectoryWriter::Format::Csv : TrajectoryWriter::Format::Binary)) {
+            fprintf(stderr, "Não foi possível abrir %s\n", trajectoryPath);
+            return 1;
+        }
+    }
+
+    std::map<unsigned char, bool> keyStates;
+    std::map<unsigned char, bool> prevKeyStates;
+
+    std::vector<double> frameMs;
+    frameMs.reserve(frameCount);
+
+    if (tracePath) Tracer::Start();
+
+    Clock::time_point runStart = Clock::now();
+    for (int f = 0; f < frameCount; f++) {
+        Clock::time_point frameStart = Clock::now();
+        if (replayer.IsOpen()) {
+            replayer.ReadFrame(keyStates);
+            world.HandleKey(keyStates, prevKeyStates);
+            prevKeyStates = keyStates;
+        }
+        recorder.WriteFrame(keyStates);
+        world.Update(deltaTime);
+        frameMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+    }
+    double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - runStart).count();
+
+    // Espera a thread de escrita esvaziar o buffer (fora do tempo medido)
+    world.CloseTrajectory();
+
+    if (tracePath) {
+        Tracer::Stop();
+        if (!Tracer::WriteJson(tracePath)) {
+            fprintf(stderr, "Não foi possível gravar %s\n", tracePath);
+            return 1;
+        }
+    }
+
+    if (savePath && !world.SaveSnapshot(savePath)) {
+        fprintf(stderr, "Não foi possível gravar o snapshot %s\n", savePath);
+        return 1;
+    }
+
+    std::sort(frameMs.begin(), frameMs.end());
+    double avgMs = totalMs / frameCount;
+    double p99Ms = frameMs[static_cast<size_t>((frameMs.size() - 1) * 0.99)];
+    size_t flockSize = world.GetFlock().Size();
+
+    printf("boids:      %zu\n", flockSize);
+    printf("frames:     %d\n", frameCount);
+    printf("seed:       %u\n", world.GetSeed());
+    printf("threads:    %d\n", world.GetThreadCount());
+    printf("obstacles:  %zu\n", world.GetObstacles().size());
+    printf("sort:       every %d frames\n", world.GetSortInterval());
+    printf("init:       %.3f ms\n", initMs);
+    printf("total:      %.3f ms\n", totalMs);
+    printf("frame:      avg %.3f ms, min %.3f ms, p99 %.3f ms, max %.3f ms\n",
+           avgMs, frameMs.front(), p99Ms, frameMs.back());
+    printf("per boid:   %.1f ns/boid/frame\n", avgMs * 1.0e6 / static_cast<double>(flockSize));
+    printf("state hash: %016llx\n", static_cast<unsigned long long>(HashFlockState(world.GetFlock().Current())));
+
+    const TrajectoryWriter& trajectory = world.GetTrajectory();
+    if (trajectoryPath) {
+        printf("trajectory: %llu frames written, %llu dropped (buffer full)\n",
+               static_cast<unsigned long long>(trajectory.GetWrittenFrames()),
+               static_cast<unsigned long long>(trajectory.GetDroppedFrames()));
+    }
+    if (tracePath) {
+        printf("trace:      %zu events, %zu dropped\n", Tracer::GetEventCount(), Tracer::GetDroppedCount());
+    }
+
+    const NeighborList& neighborList = world.GetNeighborList();
+    if (neighborList.IsEnabled()) {
+        uint64_t rebuilds = neighborList.GetRebuildCount();
+        uint64_t frames = neighborList.GetFrameCount();
+        printf("verlet:     skin %.2f, %llu rebuilds in %llu frames (1 every %.1f frames)\n",
+               neighborList.GetSkin(), static_cast<unsigned long long>(rebuilds),
+               static_cast<unsigned long long>(frames),
+               rebuilds > 0 ? static_cast<double>(frames) / static_cast<double>(rebuilds) : 0.0);
+    }
+
+    if (world.IsLodEnabled()) {
+        const World::LodStats& lod = world.GetLodStats();
+        static const char* bandNames[World::LodBandCount] = { "1/1", "1/2", "1/4", "1/8" };
+        printf("lod bands: ");
+        for (int b = 0; b < World::LodBandCount; b++) {
+            printf(" %s %.1f", bandNames[b], static_cast<double>(lod.bandCounts[b]) / frameCount);
+        }
+        printf(" boids/frame\n");
+
+        // Tempo economizado: updates pulados vezes o custo médio de um update feito
+        uint64_t total = lod.updated + lod.skipped;
+        double perUpdateMs = lod.updated > 0 ? lod.updateSeconds * 1000.0 / static_cast<double>(lod.updated) : 0.0;
+        printf("lod:        %.1f%% of boid updates skipped, ~%.3f ms saved (%.3f ms/frame)\n",
+               total > 0 ? 100.0 * static_cast<double>(lod.skipped) / static_cast<double>(total) : 0.0,
+               perUpdateMs * static_cast<double>(lod.skipped),
+               perUpdateMs * static_cast<double>(lod.skipped) / frameCount);
+    }
+
+    // Fases do Update nos últimos Profiler::WindowSize frames
+    printf("phases (last %zu frames, ms):\n", std::min(static_cast<size_t>(frameCount), Profiler::WindowSize));
+    for (int p = Profiler::UpdateTotal; p <= Profiler::UpdateCamera; p++) {
+        Profiler::Phase phase = static_cast<Profiler::Phase>(p);
+        Profiler::Stats stats = Profiler::GetStats(phase);
+        if (stats.samples == 0) continue;
+        printf("  %-17s min %8.3f  avg %8.3f  p99 %8.3f\n", Profiler::GetPhaseName(phase), stats.minMs, stats.avgMs, stats.p99Ms);
+    }
+
+    return 0;
+}
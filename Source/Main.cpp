@@ -1,15 +1,55 @@
 #include <GL/glut.h>
 #include "World.h"
+#include "Recording.h"
+#include "Profiler.h"
 #include <map>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
 
 World world;
 std::map<unsigned char, bool> keyStates;      // estado atual
 std::map<unsigned char, bool> prevKeyStates;  // estado anterior
 
+// Teclas só da interface (snapshot, HUD, tempos, trace): tratadas fora do passo
+// fixo, no teclado real, e nunca gravadas (a reprodução não repete os efeitos)
+std::map<unsigned char, bool> uiKeyStates;
+std::map<unsigned char, bool> prevUiKeyStates;
+
+// Teclas que mexem na simulação: só elas entram em keyStates e na gravação
+bool isSimulationKey(unsigned char key) {
+    return key != '\0' && strchr("adikws +-pcfqe", key) != nullptr;
+}
+
 // Tamanho da janela
 int windowWidth = 800;
 int windowHeight = 600;
 
+// Passo fixo da simulação, independente da taxa de desenho.
+// O relógio monotônico acumula o tempo real; cada passo consome simStep.
+using Clock = std::chrono::steady_clock;
+float simStep = 1.0f / 60.0f;  // --sim-rate HZ
+int maxStepsPerFrame = 5;      // --max-steps N: limite de passos para alcançar o relógio
+Clock::time_point lastTime;
+double accumulator = 0.0;
+
+// Gravação (--record F) e reprodução (--replay F) do teclado de cada passo
+Recorder recorder;
+Replayer replayer;
+
+// Snapshot gravado com a tecla 'o' (--save F)
+const char* snapshotPath = "boids.snap";
+
+// Tempos por fase: 'h' mostra o HUD, 'g' grava as amostras em timingPath
+bool showHud = false;
+const char* timingPath = "boids_timing.csv";
+
+// Trace do chrome://tracing: 't' começa e, na segunda vez, grava em tracePath (--trace F)
+const char* tracePath = "boids_trace.json";
+
 // Inicialização do OpenGL
 void initGL() {
     glClearColor(0.5f, 0.7f, 1.0f, 1.0f);
@@ -23,25 +63,142 @@ void initGL() {
     glShadeModel(GL_SMOOTH);
 }
 
+// Texto em coordenadas de pixel (origem no canto inferior esquerdo)
+void drawText(float x, float y, const char* text) {
+    glRasterPos2f(x, y);
+    for (const char* c = text; *c; c++) {
+        glutBitmapCharacter(GLUT_BITMAP_8_BY_13, *c);
+    }
+}
+
+// Tabela min/avg/p99 de cada fase por cima da cena
+void drawHud() {
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_FOG);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(0.0, windowWidth, 0.0, windowHeight);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    const float lineHeight = 15.0f;
+    float y = windowHeight - 20.0f;
+    char line[96];
+
+    glColor3f(1.0f, 1.0f, 0.3f);
+    snprintf(line, sizeof(line), "%-17s %8s %8s %8s", "fase (ms)", "min", "avg", "p99");
+    drawText(10.0f, y, line);
+    y -= lineHeight;
+
+    glColor3f(1.0f, 1.0f, 1.0f);
+    for (int p = 0; p < Profiler::PhaseCount; p++) {
+        Profiler::Phase phase = static_cast<Profiler::Phase>(p);
+        Profiler::Stats stats = Profiler::GetStats(phase);
+        snprintf(line, sizeof(line), "%-17s %8.3f %8.3f %8.3f",
+                 Profiler::GetPhaseName(phase), stats.minMs, stats.avgMs, stats.p99Ms);
+        drawText(10.0f, y, line);
+        y -= lineHeight;
+    }
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+}
+
 // Função de renderização
 void display() {
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    {
+        // O swap fica fora: com vsync ele mede a espera pelo monitor, não o desenho
+        ScopedTimer timer(Profiler::MainDisplay);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    world.Draw();
+        // Fração do próximo passo que já passou: o desenho interpola entre os dois últimos estados
+        float alpha = static_cast<float>(accumulator / simStep);
+        world.Draw(alpha);
+
+        if (showHud) drawHud();
+    }
 
     glutSwapBuffers();
 }
 
-// Atualização da simulação
+// Atualização da simulação: roda quantos passos fixos couberem no tempo real
+// decorrido e se agenda (glutTimerFunc) para quando o próximo passo vencer
 void update(int value) {
-    world.HandleKey(keyStates, prevKeyStates);
+    ScopedTimer timer(Profiler::MainUpdate);
+
+    Clock::time_point now = Clock::now();
+    accumulator += std::chrono::duration<double>(now - lastTime).count();
+    lastTime = now;
+
+    // Teclas da interface: uma vez por frame, entre passos (o snapshot sai numa fronteira de passo)
+    if (uiKeyStates['o'] && !prevUiKeyStates['o']) {
+        if (world.SaveSnapshot(snapshotPath)) printf("Snapshot gravado em %s\n", snapshotPath);
+        else fprintf(stderr, "Não foi possível gravar o snapshot %s\n", snapshotPath);
+    }
+    if (uiKeyStates['h'] && !prevUiKeyStates['h']) {
+        showHud = !showHud;
+    }
+    if (uiKeyStates['g'] && !prevUiKeyStates['g']) {
+        if (Profiler::WriteCsv(timingPath)) printf("Tempos gravados em %s\n", timingPath);
+        else fprintf(stderr, "Não foi possível gravar os tempos em %s\n", timingPath);
+    }
+    if (uiKeyStates['t'] && !prevUiKeyStates['t']) {
+        if (!Tracer::IsEnabled()) {
+            Tracer::Start();
+            printf("Trace iniciado\n");
+        }
+        else {
+            Tracer::Stop();
+            if (Tracer::WriteJson(tracePath)) printf("Trace gravado em %s (%zu eventos)\n", tracePath, Tracer::GetEventCount());
+            else fprintf(stderr, "Não foi possível gravar o trace %s\n", tracePath);
+        }
+    }
+    prevUiKeyStates = uiKeyStates;
+
+    int steps = 0;
+    while (accumulator >= simStep && steps < maxStepsPerFrame) {
+        // Na reprodução o teclado vem da gravação; quando ela acaba, volta o teclado real
+        std::map<unsigned char, bool> stepKeys;
+        if (replayer.IsOpen() && replayer.ReadFrame(stepKeys)) {
+            keyStates = stepKeys;
+        }
+        else if (replayer.IsOpen()) {
+            replayer.Close();
+            keyStates.clear();
+            printf("Fim da gravação: controle de volta ao teclado\n");
+        }
+        recorder.WriteFrame(keyStates);
 
-    // Atualiza estados anteriores
-    prevKeyStates = keyStates;
+        world.HandleKey(keyStates, prevKeyStates);
 
-    world.Update(0.016f); // 60 FPS
-    glutPostRedisplay();
-    glutTimerFunc(16, update, 0);
+        // Atualiza estados anteriores
+        prevKeyStates = keyStates;
+
+        world.Update(simStep);
+        accumulator -= simStep;
+        steps++;
+    }
+
+    // Se o desenho travou por muito tempo, descarta o atraso em vez de
+    // tentar alcançá-lo (senão cada frame fica mais lento que o anterior)
+    if (accumulator >= simStep) {
+        accumulator = 0.0;
+    }
+
+    // Só redesenha quando o estado andou; entre passos o laço do GLUT fica parado
+    if (steps > 0) {
+        glutPostRedisplay();
+    }
+    int delayMs = static_cast<int>(std::ceil((simStep - accumulator) * 1000.0));
+    glutTimerFunc(static_cast<unsigned int>(Math::Max(delayMs, 1)), update, 0);
 }
 
 // Redimensionamento
@@ -56,10 +213,20 @@ void reshape(int w, int h) {
 }
 
 void keyboard(unsigned char key, int x, int y) {
+    if (!isSimulationKey(key)) {
+        uiKeyStates[key] = true;
+        return;
+    }
+    if (replayer.IsOpen()) return; // Durante a reprodução o teclado é o da gravação
     keyStates[key] = true; // marca como pressionada
 }
 
 void keyboardUp(unsigned char key, int x, int y) {
+    if (!isSimulationKey(key)) {
+        uiKeyStates[key] = false;
+        return;
+    }
+    if (replayer.IsOpen()) return;
     keyStates[key] = false; // marca como solta
 }
 
@@ -69,15 +236,106 @@ int main(int argc, char** argv) {
     glutInitWindowSize(windowWidth, windowHeight);
     glutCreateWindow("Boids 3D");
 
+    // Threads da simulação: --threads N (1 = serial). Padrão: todos os núcleos
+    // Passo fixo: --sim-rate HZ (padrão 60), --max-steps N passos por frame (padrão 5)
+    // Execução reproduzível: --seed N, --record arquivo, --replay arquivo
+    // Snapshot: --load arquivo começa dele, a tecla 'o' grava em --save arquivo
+    // Trajetórias: --trajectory arquivo (.csv ou binário)
+    // Trace: a tecla 't' liga/desliga e grava em --trace arquivo
+    int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* loadPath = nullptr;
+    const char* trajectoryPath = nullptr;
+    for (int i = 1; i < argc - 1; i++) {
+        if (strcmp(argv[i], "--threads") == 0) {
+            threadCount = atoi(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--sim-rate") == 0) {
+            float rate = static_cast<float>(atof(argv[i + 1]));
+            if (rate > 0.0f) simStep = 1.0f / rate;
+        }
+        else if (strcmp(argv[i], "--max-steps") == 0) {
+            maxStepsPerFrame = Math::Max(atoi(argv[i + 1]), 1);
+        }
+        else if (strcmp(argv[i], "--seed") == 0) {
+            world.SetSeed(static_cast<uint32_t>(atoll(argv[i + 1])));
+        }
+        else if (strcmp(argv[i], "--record") == 0) {
+            recordPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--replay") == 0) {
+            replayPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--load") == 0) {
+            loadPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--save") == 0) {
+            snapshotPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--trajectory") == 0) {
+            trajectoryPath = argv[i + 1];
+        }
+        else if (strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[i + 1];
+        }
+    }
+    world.SetThreadCount(threadCount);
+
+    // A gravação parte do World::Init; não combina com um snapshot
+    if (loadPath && (recordPath || replayPath)) {
+        fprintf(stderr, "--load não pode ser usado com --record/--replay\n");
+        return 1;
+    }
+
+    // Na reprodução a configuração (semente, passo, tamanho do bando...) vem da gravação
+    int boidCount = 30;
+    int extraObstacles = 0;
+    if (replayPath) {
+        if (!replayer.Open(replayPath)) {
+            fprintf(stderr, "Não foi possível ler a gravação %s\n", replayPath);
+            return 1;
+        }
+        const RecordHeader& header = replayer.GetHeader();
+        header.Apply(world);
+        simStep = header.deltaTime;
+        boidCount = static_cast<int>(header.boidCount);
+        extraObstacles = static_cast<int>(header.extraObstacles);
+    }
+
     initGL();
-    world.Init();
+    if (loadPath) {
+        if (!world.LoadSnapshot(loadPath)) {
+            fprintf(stderr, "Não foi possível carregar o snapshot %s\n", loadPath);
+            return 1;
+        }
+    }
+    else {
+        world.Init(boidCount);
+        world.AddRandomObstacles(extraObstacles);
+    }
+
+    if (recordPath && !recorder.Open(recordPath, RecordHeader::Capture(world, boidCount, extraObstacles, simStep))) {
+        fprintf(stderr, "Não foi possível abrir %s\n", recordPath);
+        return 1;
+    }
+
+    if (trajectoryPath) {
+        size_t length = strlen(trajectoryPath);
+        bool csv = length >= 4 && strcmp(trajectoryPath + length - 4, ".csv") == 0;
+        if (!world.OpenTrajectory(trajectoryPath, csv ? TrajectoryWriter::Format::Csv : TrajectoryWriter::Format::Binary)) {
+            fprintf(stderr, "Não foi possível abrir %s\n", trajectoryPath);
+            return 1;
+        }
+    }
 
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);
     glutKeyboardFunc(keyboard);
     glutKeyboardUpFunc(keyboardUp);
-    glutTimerFunc(16, update, 0);
+    glutTimerFunc(0, update, 0);
 
+    lastTime = Clock::now();
     glutMainLoop();
     return 0;
 }
\ No newline at end of file
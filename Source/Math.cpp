@@ -1,5 +1,10 @@
 #include "Math.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SSE2 1
+#include <emmintrin.h>
+#endif
+
 static float m3Ident[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
 const Matrix3 Matrix3::Identity(m3Ident);
 
@@ -75,6 +80,48 @@ Vector4 Vector4::Transform(const Vector4& vec, const Matrix4& mat)
 	return retVal;
 }
 
+#ifdef MATH_SSE2
+// SHUFFLE(a, b, i, j, k, l) gives (a[i], a[j], b[k], b[l])
+#define SHUFFLE_MASK(i, j, k, l) ((i) | ((j) << 2) | ((k) << 4) | ((l) << 6))
+#define SHUFFLE(a, b, i, j, k, l) _mm_shuffle_ps((a), (b), SHUFFLE_MASK(i, j, k, l))
+
+// Load 4 packed Vector3s (12 floats) as x, y and z lanes
+static inline void LoadVector3x4(const Vector3* v, __m128& x, __m128& y, __m128& z)
+{
+	const float* f = &v->x;
+	__m128 a = _mm_loadu_ps(f);     // x0 y0 z0 x1
+	__m128 b = _mm_loadu_ps(f + 4); // y1 z1 x2 y2
+	__m128 c = _mm_loadu_ps(f + 8); // z2 x3 y3 z3
+	x = SHUFFLE(a, SHUFFLE(b, c, 2, 2, 1, 1), 0, 3, 0, 2);
+	y = SHUFFLE(SHUFFLE(a, b, 1, 1, 0, 0), SHUFFLE(b, c, 3, 3, 2, 2), 0, 2, 0, 2);
+	z = SHUFFLE(SHUFFLE(a, b, 2, 2, 1, 1), c, 0, 2, 0, 3);
+}
+#endif
+
+void Vector3::DistanceSqArray(const Vector3& point, const Vector3* positions, float* outDistSq,
+							  size_t count)
+{
+	size_t i = 0;
+#ifdef MATH_SSE2
+	__m128 px = _mm_set1_ps(point.x);
+	__m128 py = _mm_set1_ps(point.y);
+	__m128 pz = _mm_set1_ps(point.z);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x, y, z;
+		LoadVector3x4(positions + i, x, y, z);
+		x = _mm_sub_ps(x, px);
+		y = _mm_sub_ps(y, py);
+		z = _mm_sub_ps(z, pz);
+		_mm_storeu_ps(outDistSq + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+	}
+#endif
+	for (; i < count; i++)
+	{
+		outDistSq[i] = (positions[i] - point).LengthSq();
+	}
+}
+
 void Matrix4::Invert()
 {
 	// Thanks slow math
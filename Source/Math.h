@@ -4,9 +4,17 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory.h>
 #include <limits>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MATH_HAS_RSQRT 1
+#include <xmmintrin.h>
+#endif
+
 namespace Math
 {
 	// NOLINTBEGIN
@@ -103,6 +111,97 @@ namespace Math
 			return -1.0f;
 		return 0.0f;
 	}
+
+	// Approximations for the per-boid hot loop. Error bounds are the maximum
+	// measured by boids_bench over the stated domain (absolute unless noted).
+	namespace Fast
+	{
+		// 1 / sqrt(value) for value > 0: hardware estimate (rsqrtss, or the bit
+		// trick without SSE) refined by one Newton-Raphson step.
+		// Relative error < 3e-7 with SSE (2.7e-7 over every float in [1, 4)).
+		[[nodiscard]] inline float InvSqrt(float value)
+		{
+#ifdef MATH_HAS_RSQRT
+			float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+#else
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			bits = 0x5f375a86u - (bits >> 1);
+			float y;
+			memcpy(&y, &bits, sizeof(y));
+			y = y * (1.5f - 0.5f * value * y * y);
+#endif
+			return y * (1.5f - 0.5f * value * y * y);
+		}
+
+		// atan2(y, x) in radians: degree 11 odd polynomial for atan on the
+		// min/max ratio in [0, 1], then octant fix-up. Error < 2e-6 rad;
+		// returns +-0 for (+-0, 0).
+		[[nodiscard]] inline float Atan2(float y, float x)
+		{
+			float ax = fabsf(x);
+			float ay = fabsf(y);
+			float mx = ax > ay ? ax : ay;
+			float a = (ax < ay ? ax : ay) / (mx > 0.0f ? mx : 1.0f);
+			float s = a * a;
+			float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f +
+				s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+			// Selects instead of branches: the octant is random for random inputs
+			r = ay > ax ? PiOver2 - r : r;
+			r = x < 0.0f ? Pi - r : r;
+			return copysignf(r, y);
+		}
+
+		// asin(value) for value in [-1, 1] (Abramowitz & Stegun 4.4.45).
+		// Error < 7e-5 rad.
+		[[nodiscard]] inline float Asin(float value)
+		{
+			float x = fabsf(value);
+			float r = PiOver2 - sqrtf(1.0f - x) *
+				(((-0.0187293f * x + 0.0742610f) * x - 0.2121144f) * x + 1.5707288f);
+			return copysignf(r, value);
+		}
+
+		// sin(angle): reduced to [-Pi/2, Pi/2], then a degree 9 odd polynomial.
+		// Error < 4e-6 for |angle| <= TwoPi (3.7e-6 over every float in that
+		// range); the float range reduction adds about |angle| * 6e-8 beyond that.
+		[[nodiscard]] inline float Sin(float angle)
+		{
+			// Nearest multiple of TwoPi via a truncating conversion (no libm call),
+			// then fold |x| > Pi/2 onto Pi - |x| without branches
+			float turns = angle * (1.0f / TwoPi);
+			float x = angle - TwoPi * static_cast<float>(static_cast<int>(turns + copysignf(0.5f, turns)));
+			x = copysignf(PiOver2 - fabsf(PiOver2 - fabsf(x)), x);
+			float s = x * x;
+			return x * (1.0f + s * (-1.0f / 6.0f + s * (1.0f / 120.0f + s * (-1.0f / 5040.0f + s * (1.0f / 362880.0f)))));
+		}
+
+		[[nodiscard]] inline float Cos(float angle)
+		{
+			return Sin(angle + PiOver2);
+		}
+	} // namespace Fast
+
+	// The standard library versions, with the same names as Fast
+	namespace Exact
+	{
+		[[nodiscard]] inline float InvSqrt(float value) { return 1.0f / sqrtf(value); }
+		[[nodiscard]] inline float Atan2(float y, float x) { return atan2f(y, x); }
+		[[nodiscard]] inline float Asin(float value) { return asinf(value); }
+		[[nodiscard]] inline float Sin(float angle) { return sinf(angle); }
+		[[nodiscard]] inline float Cos(float angle) { return cosf(angle); }
+	} // namespace Exact
+
+	// Compile-time policy for the hot loop (Boid::Update, wing animation):
+	// Exact by default, Fast when built with -DBOIDS_FAST_MATH=ON. The fast
+	// build is not bit-compatible with recordings made by the exact one.
+#ifdef BOIDS_FAST_MATH
+	namespace Hot = Fast;
+	constexpr bool IsFastMath = true;
+#else
+	namespace Hot = Exact;
+	constexpr bool IsFastMath = false;
+#endif
 } // namespace Math
 
 // 2D Vector
@@ -408,6 +507,28 @@ public:
 		return temp;
 	}
 
+	// Normalize under the Math::Hot policy: Normalize() in the exact build,
+	// multiply by Fast::InvSqrt in the fast one
+	void NormalizeHot()
+	{
+		if constexpr (Math::IsFastMath)
+		{
+			float invLength = Math::Hot::InvSqrt(LengthSq());
+			x *= invLength;
+			y *= invLength;
+			z *= invLength;
+		}
+		else
+		{
+			Normalize();
+		}
+	}
+
+	// outDistSq[i] = (positions[i] - point).LengthSq() over a contiguous array
+	// (SSE2 when available, 4 vectors per iteration; bit-identical to the scalar loop)
+	static void DistanceSqArray(const Vector3& point, const Vector3* positions, float* outDistSq,
+								size_t count);
+
 	// Dot product between two vectors (a dot b)
 	[[nodiscard]] static float Dot(const Vector3& a, const Vector3& b)
 	{
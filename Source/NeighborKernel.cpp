@@ -0,0 +1,273 @@
+#include "NeighborKernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BOIDS_KERNEL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define BOIDS_KERNEL_X86 0
+#endif
+
+// GCC/Clang só geram AVX2 em funções marcadas; o MSVC aceita os intrínsecos direto
+#if defined(__GNUC__) || defined(__clang__)
+#define BOIDS_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define BOIDS_TARGET_AVX2
+#endif
+
+namespace
+{
+    // Mesmos limiares do laço original: dist > 0.001 e push.LengthSq() > 0.001
+    constexpr float MinDistSq = 0.001f * 0.001f;
+    constexpr float MinPushSq = 0.001f;
+
+    void AccumulateScalar(const NeighborArrays& a, const NeighborRange* ranges, int rangeCount,
+                          const Vector3& p, float perceptionRadius, float separationRadius,
+                          NeighborSums& sums)
+    {
+        const float r2 = perceptionRadius * perceptionRadius;
+        const float s2 = separationRadius * separationRadius;
+
+        for (int r = 0; r < rangeCount; r++) {
+            for (uint32_t i = ranges[r].begin; i < ranges[r].end; i++) {
+                float dx = p.x - a.x[i];
+                float dy = p.y - a.y[i];
+                float dz = p.z - a.z[i];
+                float d2 = dx * dx + dy * dy + dz * dz;
+
+                if (d2 > MinDistSq && d2 < r2) {
+                    if (d2 < s2 && d2 > MinPushSq) {
+                        float inv = 1.0f / d2;
+                        sums.separation += Vector3(dx * inv, dy * inv, dz * inv);
+                    }
+                    sums.alignment += Vector3(a.vx[i], a.vy[i], a.vz[i]);
+                    sums.centerOfMass += Vector3(a.x[i], a.y[i], a.z[i]);
+                    sums.count++;
+                }
+            }
+        }
+    }
+
+#if BOIDS_KERNEL_X86
+    float HorizontalSum(__m128 v)
+    {
+        __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 sums = _mm_add_ps(v, shuf);
+        shuf = _mm_movehl_ps(shuf, sums);
+        sums = _mm_add_ss(sums, shuf);
+        return _mm_cvtss_f32(sums);
+    }
+
+    void AccumulateSSE2(const NeighborArrays& a, const NeighborRange* ranges, int rangeCount,
+                        const Vector3& p, float perceptionRadius, float separationRadius,
+                        NeighborSums& sums)
+    {
+        const __m128 px = _mm_set1_ps(p.x);
+        const __m128 py = _mm_set1_ps(p.y);
+        const __m128 pz = _mm_set1_ps(p.z);
+        const __m128 r2 = _mm_set1_ps(perceptionRadius * perceptionRadius);
+        const __m128 s2 = _mm_set1_ps(separationRadius * separationRadius);
+        const __m128 minDist = _mm_set1_ps(MinDistSq);
+        const __m128 minPush = _mm_set1_ps(MinPushSq);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+        __m128 sepX = _mm_setzero_ps(), sepY = _mm_setzero_ps(), sepZ = _mm_setzero_ps();
+        __m128 aliX = _mm_setzero_ps(), aliY = _mm_setzero_ps(), aliZ = _mm_setzero_ps();
+        __m128 comX = _mm_setzero_ps(), comY = _mm_setzero_ps(), comZ = _mm_setzero_ps();
+        __m128 count = _mm_setzero_ps();
+
+        for (int r = 0; r < rangeCount; r++) {
+            const uint32_t end = ranges[r].end;
+            for (uint32_t i = ranges[r].begin; i < end; i += 4) {
+                // Último bloco da faixa: as sobras são mascaradas (os arrays têm folga)
+                __m128 valid = _mm_cmplt_ps(lane, _mm_set1_ps(static_cast<float>(end - i)));
+
+                __m128 ox = _mm_loadu_ps(a.x + i);
+                __m128 oy = _mm_loadu_ps(a.y + i);
+                __m128 oz = _mm_loadu_ps(a.z + i);
+                __m128 dx = _mm_sub_ps(px, ox);
+                __m128 dy = _mm_sub_ps(py, oy);
+                __m128 dz = _mm_sub_ps(pz, oz);
+                __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+                __m128 inRange = _mm_and_ps(valid, _mm_and_ps(_mm_cmpgt_ps(d2, minDist), _mm_cmplt_ps(d2, r2)));
+                __m128 inSep = _mm_and_ps(inRange, _mm_and_ps(_mm_cmplt_ps(d2, s2), _mm_cmpgt_ps(d2, minPush)));
+                __m128 inv = _mm_div_ps(one, d2);
+
+                sepX = _mm_add_ps(sepX, _mm_and_ps(inSep, _mm_mul_ps(dx, inv)));
+                sepY = _mm_add_ps(sepY, _mm_and_ps(inSep, _mm_mul_ps(dy, inv)));
+                sepZ = _mm_add_ps(sepZ, _mm_and_ps(inSep, _mm_mul_ps(dz, inv)));
+
+                aliX = _mm_add_ps(aliX, _mm_and_ps(inRange, _mm_loadu_ps(a.vx + i)));
+                aliY = _mm_add_ps(aliY, _mm_and_ps(inRange, _mm_loadu_ps(a.vy + i)));
+                aliZ = _mm_add_ps(aliZ, _mm_and_ps(inRange, _mm_loadu_ps(a.vz + i)));
+
+                comX = _mm_add_ps(comX, _mm_and_ps(inRange, ox));
+                comY = _mm_add_ps(comY, _mm_and_ps(inRange, oy));
+                comZ = _mm_add_ps(comZ, _mm_and_ps(inRange, oz));
+
+                count = _mm_add_ps(count, _mm_and_ps(inRange, one));
+            }
+        }
+
+        sums.separation += Vector3(HorizontalSum(sepX), HorizontalSum(sepY), HorizontalSum(sepZ));
+        sums.alignment += Vector3(HorizontalSum(aliX), HorizontalSum(aliY), HorizontalSum(aliZ));
+        sums.centerOfMass += Vector3(HorizontalSum(comX), HorizontalSum(comY), HorizontalSum(comZ));
+        sums.count += static_cast<int>(HorizontalSum(count));
+    }
+
+    BOIDS_TARGET_AVX2 float HorizontalSum256(__m256 v)
+    {
+        __m128 lo = _mm256_castps256_ps128(v);
+        __m128 hi = _mm256_extractf128_ps(v, 1);
+        __m128 s = _mm_add_ps(lo, hi);
+        __m128 shuf = _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 3, 0, 1));
+        s = _mm_add_ps(s, shuf);
+        shuf = _mm_movehl_ps(shuf, s);
+        s = _mm_add_ss(s, shuf);
+        return _mm_cvtss_f32(s);
+    }
+
+    BOIDS_TARGET_AVX2 void AccumulateAVX2(const NeighborArrays& a, const NeighborRange* ranges, int rangeCount,
+                                          const Vector3& p, float perceptionRadius, float separationRadius,
+                                          NeighborSums& sums)
+    {
+        const __m256 px = _mm256_set1_ps(p.x);
+        const __m256 py = _mm256_set1_ps(p.y);
+        const __m256 pz = _mm256_set1_ps(p.z);
+        const __m256 r2 = _mm256_set1_ps(perceptionRadius * perceptionRadius);
+        const __m256 s2 = _mm256_set1_ps(separationRadius * separationRadius);
+        const __m256 minDist = _mm256_set1_ps(MinDistSq);
+        const __m256 minPush = _mm256_set1_ps(MinPushSq);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+        __m256 sepX = _mm256_setzero_ps(), sepY = _mm256_setzero_ps(), sepZ = _mm256_setzero_ps();
+        __m256 aliX = _mm256_setzero_ps(), aliY = _mm256_setzero_ps(), aliZ = _mm256_setzero_ps();
+        __m256 comX = _mm256_setzero_ps(), comY = _mm256_setzero_ps(), comZ = _mm256_setzero_ps();
+        __m256 count = _mm256_setzero_ps();
+
+        for (int r = 0; r < rangeCount; r++) {
+            const uint32_t end = ranges[r].end;
+            for (uint32_t i = ranges[r].begin; i < end; i += 8) {
+                // Último bloco da faixa: as sobras são mascaradas (os arrays têm folga)
+                __m256 valid = _mm256_cmp_ps(lane, _mm256_set1_ps(static_cast<float>(end - i)), _CMP_LT_OQ);
+
+                __m256 ox = _mm256_loadu_ps(a.x + i);
+                __m256 oy = _mm256_loadu_ps(a.y + i);
+                __m256 oz = _mm256_loadu_ps(a.z + i);
+                __m256 dx = _mm256_sub_ps(px, ox);
+                __m256 dy = _mm256_sub_ps(py, oy);
+                __m256 dz = _mm256_sub_ps(pz, oz);
+                __m256 d2 = _mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dz, dz)));
+
+                __m256 inRange = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(d2, minDist, _CMP_GT_OQ),
+                                                                    _mm256_cmp_ps(d2, r2, _CMP_LT_OQ)));
+                __m256 inSep = _mm256_and_ps(inRange, _mm256_and_ps(_mm256_cmp_ps(d2, s2, _CMP_LT_OQ),
+                                                                    _mm256_cmp_ps(d2, minPush, _CMP_GT_OQ)));
+                __m256 inv = _mm256_div_ps(one, d2);
+
+                sepX = _mm256_add_ps(sepX, _mm256_and_ps(inSep, _mm256_mul_ps(dx, inv)));
+                sepY = _mm256_add_ps(sepY, _mm256_and_ps(inSep, _mm256_mul_ps(dy, inv)));
+                sepZ = _mm256_add_ps(sepZ, _mm256_and_ps(inSep, _mm256_mul_ps(dz, inv)));
+
+                aliX = _mm256_add_ps(aliX, _mm256_and_ps(inRange, _mm256_loadu_ps(a.vx + i)));
+                aliY = _mm256_add_ps(aliY, _mm256_and_ps(inRange, _mm256_loadu_ps(a.vy + i)));
+                aliZ = _mm256_add_ps(aliZ, _mm256_and_ps(inRange, _mm256_loadu_ps(a.vz + i)));
+
+                comX = _mm256_add_ps(comX, _mm256_and_ps(inRange, ox));
+                comY = _mm256_add_ps(comY, _mm256_and_ps(inRange, oy));
+                comZ = _mm256_add_ps(comZ, _mm256_and_ps(inRange, oz));
+
+                count = _mm256_add_ps(count, _mm256_and_ps(inRange, one));
+            }
+        }
+
+        sums.separation += Vector3(HorizontalSum256(sepX), HorizontalSum256(sepY), HorizontalSum256(sepZ));
+        sums.alignment += Vector3(HorizontalSum256(aliX), HorizontalSum256(aliY), HorizontalSum256(aliZ));
+        sums.centerOfMass += Vector3(HorizontalSum256(comX), HorizontalSum256(comY), HorizontalSum256(comZ));
+        sums.count += static_cast<int>(HorizontalSum256(count));
+    }
+#endif
+
+    NeighborKernel::Isa& CurrentIsa()
+    {
+        static NeighborKernel::Isa isa = NeighborKernel::DetectIsa();
+        return isa;
+    }
+}
+
+namespace NeighborKernel
+{
+    void Accumulate(const NeighborArrays& arrays, const NeighborRange* ranges, int rangeCount,
+                    const Vector3& position, float perceptionRadius, float separationRadius,
+                    NeighborSums& sums)
+    {
+        switch (CurrentIsa()) {
+#if BOIDS_KERNEL_X86
+        case Isa::AVX2:
+            AccumulateAVX2(arrays, ranges, rangeCount, position, perceptionRadius, separationRadius, sums);
+            break;
+        case Isa::SSE2:
+            AccumulateSSE2(arrays, ranges, rangeCount, position, perceptionRadius, separationRadius, sums);
+            break;
+#endif
+        default:
+            AccumulateScalar(arrays, ranges, rangeCount, position, perceptionRadius, separationRadius, sums);
+            break;
+        }
+    }
+
+    Isa DetectIsa()
+    {
+#if BOIDS_KERNEL_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            bool fma = (info[2] & (1 << 12)) != 0;
+            __cpuidex(info, 7, 0);
+            bool avx2 = (info[1] & (1 << 5)) != 0;
+            // O SO também precisa salvar os registradores YMM
+            if (osxsave && avx && fma && avx2 && (_xgetbv(0) & 6) == 6) {
+                return Isa::AVX2;
+            }
+        }
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return Isa::AVX2;
+        }
+#endif
+        return Isa::SSE2;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    Isa GetIsa()
+    {
+        return CurrentIsa();
+    }
+
+    void SetIsa(Isa isa)
+    {
+        Isa best = DetectIsa();
+        CurrentIsa() = (static_cast<int>(isa) > static_cast<int>(best)) ? best : isa;
+    }
+
+    const char* GetIsaName(Isa isa)
+    {
+        switch (isa) {
+        case Isa::AVX2: return "avx2";
+        case Isa::SSE2: return "sse2";
+        default: return "scalar";
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Math.h"
+#include <cstddef>
+#include <cstdint>
+
+// Posições e velocidades dos candidatos a vizinho em arrays separados (SoA)
+struct NeighborArrays {
+    const float* x;
+    const float* y;
+    const float* z;
+    const float* vx;
+    const float* vy;
+    const float* vz;
+};
+
+// Faixa contígua [begin, end) dentro de NeighborArrays
+struct NeighborRange {
+    uint32_t begin;
+    uint32_t end;
+};
+
+// Somas de separação, alinhamento e coesão de um boid
+struct NeighborSums {
+    Vector3 separation;
+    Vector3 alignment;
+    Vector3 centerOfMass;
+    int count = 0;
+};
+
+// Kernel das forças de vizinhança. Para cada candidato dentro do raio de
+// percepção soma velocidade (alinhamento) e posição (coesão); dentro do raio
+// de separação soma push / dist, com push normalizado, ou seja (p - o) / dist².
+// Não usa sqrt: compara distâncias ao quadrado, e o resultado bate com o laço
+// escalar original dentro do erro de arredondamento.
+//
+// A implementação é escolhida em tempo de execução pela CPU: AVX2+FMA (8
+// candidatos por iteração), SSE2 (4 por iteração, base do x86-64) ou escalar.
+namespace NeighborKernel
+{
+    enum class Isa {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    // Folga exigida no fim dos arrays: o kernel lê blocos inteiros e mascara as sobras
+    constexpr size_t Padding = 8;
+
+    void Accumulate(const NeighborArrays& arrays, const NeighborRange* ranges, int rangeCount,
+                    const Vector3& position, float perceptionRadius, float separationRadius,
+                    NeighborSums& sums);
+
+    // Melhor implementação suportada pela CPU
+    Isa DetectIsa();
+
+    // Implementação em uso. SetIsa permite forçar uma (benchmarks, replays
+    // que precisam do mesmo resultado em máquinas diferentes); pedir uma que a
+    // CPU não suporta cai para a melhor disponível.
+    Isa GetIsa();
+    void SetIsa(Isa isa);
+    const char* GetIsaName(Isa isa);
+}
@@ -0,0 +1,181 @@
+#include "NeighborList.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Boids por bloco do build (cada bloco junta as próprias faixas antes da cópia final)
+static constexpr size_t kBuildGrain = 256;
+
+// Buracos de até tantos slots entre dois vizinhos não abrem faixa nova: ler
+// alguns candidatos a mais custa menos no kernel SIMD do que uma faixa curta
+static constexpr uint32_t kMaxRunGap = 8;
+
+// Índice do bit 1 mais baixo (value != 0)
+static inline uint32_t LowestBit(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+// Rascunho do build por thread; o bitmap volta zerado depois de cada boid
+static thread_local std::vector<uint32_t> tSlotWords;
+static thread_local std::vector<uint64_t> tSlotBits;
+
+NeighborList::NeighborList()
+    :mSkin(0.0f)
+    ,mValid(false)
+    ,mGrid(1.0f)
+    ,mRebuildCount(0)
+    ,mFrameCount(0)
+{
+}
+
+void NeighborList::SetSkin(float skin) {
+    mSkin = Math::Max(skin, 0.0f);
+    mValid = false;
+}
+
+void NeighborList::Update(const FlockArray<Vector3>& positions, const FlockArray<Vector3>& velocities,
+                          float perceptionRadius, ThreadPool& threadPool) {
+    mFrameCount++;
+
+    if (!mValid || NeedsRebuild(positions)) {
+        Rebuild(positions, perceptionRadius, threadPool);
+    }
+    CopyState(positions, velocities, threadPool);
+}
+
+void NeighborList::CopyState(const FlockArray<Vector3>& positions, const FlockArray<Vector3>& velocities,
+                             ThreadPool& threadPool) {
+    const size_t count = positions.size();
+
+    // Folga no fim para o kernel poder ler blocos inteiros
+    const size_t padded = count + NeighborKernel::Padding;
+    mX.resize(padded, 0.0f);
+    mY.resize(padded, 0.0f);
+    mZ.resize(padded, 0.0f);
+    mVX.resize(padded, 0.0f);
+    mVY.resize(padded, 0.0f);
+    mVZ.resize(padded, 0.0f);
+
+    threadPool.ParallelFor(count, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            mX[i] = positions[i].x;
+            mY[i] = positions[i].y;
+            mZ[i] = positions[i].z;
+            mVX[i] = velocities[i].x;
+            mVY[i] = velocities[i].y;
+            mVZ[i] = velocities[i].z;
+        }
+    }, "verlet.copy");
+}
+
+NeighborArrays NeighborList::GetArrays() const {
+    return { mX.data(), mY.data(), mZ.data(), mVX.data(), mVY.data(), mVZ.data() };
+}
+
+bool NeighborList::NeedsRebuild(const FlockArray<Vector3>& positions) const {
+    if (positions.size() != mBuildPositions.size()) return true;
+
+    const float limitSq = (mSkin * 0.5f) * (mSkin * 0.5f);
+    for (size_t i = 0; i < positions.size(); i++) {
+        if ((positions[i] - mBuildPositions[i]).LengthSq() > limitSq) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void NeighborList::Rebuild(const FlockArray<Vector3>& positions, float perceptionRadius, ThreadPool& threadPool) {
+    const size_t count = positions.size();
+    const float listRadius = perceptionRadius + mSkin;
+    const float listRadiusSq = listRadius * listRadius;
+
+    mGrid.SetCellSize(listRadius);
+    mGrid.Build(positions);
+
+    // Cada bloco acha os vizinhos dos seus boids e junta os slots em faixas
+    // crescentes (o próprio boid entra na faixa; o kernel descarta distância
+    // zero). A contagem de faixas de cada boid fica em mOffsets[i + 1].
+    mOffsets.assign(count + 1, 0);
+    mChunkRanges.resize((count + kBuildGrain - 1) / kBuildGrain);
+    threadPool.ParallelFor(count, kBuildGrain, [&](size_t begin, size_t end) {
+        std::vector<NeighborRange>& ranges = mChunkRanges[begin / kBuildGrain];
+        ranges.clear();
+        std::vector<uint32_t>& words = tSlotWords;
+        std::vector<uint64_t>& bits = tSlotBits;
+        if (bits.size() < (count + 63) / 64) bits.resize((count + 63) / 64, 0);
+
+        for (size_t i = begin; i < end; i++) {
+            const Vector3 p = positions[i];
+
+            // Marca os vizinhos num bitmap de slots. Dentro de cada balde os
+            // slots são crescentes, então os bits de uma mesma palavra são
+            // juntados num registrador antes de ir para a memória.
+            uint64_t pending = 0;
+            uint32_t pendingWord = 0;
+            auto flush = [&]() {
+                if (pending == 0) return;
+                uint64_t old = bits[pendingWord];
+                bits[pendingWord] = old | pending;
+                if (old == 0) words.push_back(pendingWord);
+            };
+
+            words.clear();
+            mGrid.ForEachCandidate(p, [&](uint32_t j) {
+                uint64_t inside = (positions[j] - p).LengthSq() < listRadiusSq;
+                if (j / 64 != pendingWord) {
+                    flush();
+                    pendingWord = j / 64;
+                    pending = 0;
+                }
+                pending |= inside << (j % 64);
+            });
+            flush();
+
+            // Varre as palavras marcadas em ordem, uma sequência de bits 1 por vez
+            std::sort(words.begin(), words.end());
+            size_t first = ranges.size();
+            for (uint32_t w : words) {
+                uint64_t word = bits[w];
+                bits[w] = 0;
+                while (word != 0) {
+                    uint32_t start = LowestBit(word);
+                    uint64_t zeros = ~(word >> start);
+                    uint32_t length = (zeros == 0) ? 64 - start : LowestBit(zeros);
+                    uint32_t runBegin = w * 64 + start;
+                    uint32_t runEnd = runBegin + length;
+                    if (ranges.size() > first && runBegin <= ranges.back().end + kMaxRunGap) {
+                        ranges.back().end = runEnd;
+                    }
+                    else {
+                        ranges.push_back({ runBegin, runEnd });
+                    }
+                    word = (start + length >= 64) ? 0 : word & (~uint64_t(0) << (start + length));
+                }
+            }
+            mOffsets[i + 1] = static_cast<uint32_t>(ranges.size() - first);
+        }
+    }, "verlet.build");
+
+    for (size_t i = 0; i < count; i++) {
+        mOffsets[i + 1] += mOffsets[i];
+    }
+
+    // Junta as faixas dos blocos na ordem dos slots
+    mRanges.resize(mOffsets[count]);
+    threadPool.ParallelFor(count, kBuildGrain, [&](size_t begin, size_t) {
+        const std::vector<NeighborRange>& ranges = mChunkRanges[begin / kBuildGrain];
+        std::copy(ranges.begin(), ranges.end(), mRanges.begin() + mOffsets[begin]);
+    }, "verlet.fill");
+
+    mBuildPositions.assign(positions.begin(), positions.end());
+    mValid = true;
+    mRebuildCount++;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "Math.h"
+#include "FlockArray.h"
+#include "SpatialGrid.h"
+#include "NeighborKernel.h"
+#include <vector>
+#include <cstdint>
+
+class ThreadPool;
+
+// Lista de vizinhos de Verlet: guarda, para cada boid, quem estava a menos de
+// raio de percepção + skin no último build. Enquanto nenhum boid andou mais
+// que skin / 2 desde então, todo vizinho real (dentro do raio) continua na
+// lista, e ela pode ser reaproveitada em vez de consultar a grade todo frame.
+//
+// A lista de cada boid é guardada como faixas contíguas de slots, não como
+// índices soltos: com o bando na ordem de Morton os vizinhos ficam em poucos
+// trechos de slots, e o kernel percorre essas faixas direto numa cópia SoA das
+// posições e velocidades (refeita a cada frame, na ordem dos slots), sem juntar
+// vizinho por vizinho. Slots que não são vizinhos no meio de uma faixa (e o
+// próprio boid) passam pelo teste de distância do kernel como os da grade.
+class NeighborList {
+public:
+    NeighborList();
+
+    // Margem extra em torno do raio de percepção (0 = lista desligada)
+    void SetSkin(float skin);
+    float GetSkin() const { return mSkin; }
+    bool IsEnabled() const { return mSkin > 0.0f; }
+
+    // Os índices da lista ficam inválidos quando os slots mudam (boid
+    // adicionado/removido, reordenação do bando); força um rebuild no próximo Update
+    void Invalidate() { mValid = false; }
+
+    // Chamado uma vez por frame com o estado atual. Reconstrói a lista se ela
+    // estiver inválida ou se algum boid andou mais que skin / 2, e atualiza a cópia SoA.
+    void Update(const FlockArray<Vector3>& positions, const FlockArray<Vector3>& velocities,
+                float perceptionRadius, ThreadPool& threadPool);
+
+    // Faixas de GetArrays() com os candidatos a vizinho do boid no slot index
+    const NeighborRange* GetRanges(size_t index) const { return mRanges.data() + mOffsets[index]; }
+    int GetRangeCount(size_t index) const { return static_cast<int>(mOffsets[index + 1] - mOffsets[index]); }
+
+    // Posições e velocidades do frame atual por slot (com folga no final para leituras SIMD)
+    NeighborArrays GetArrays() const;
+
+    // Estatísticas: quantos rebuilds em quantos frames
+    uint64_t GetRebuildCount() const { return mRebuildCount; }
+    uint64_t GetFrameCount() const { return mFrameCount; }
+
+private:
+    bool NeedsRebuild(const FlockArray<Vector3>& positions) const;
+    void Rebuild(const FlockArray<Vector3>& positions, float perceptionRadius, ThreadPool& threadPool);
+    void CopyState(const FlockArray<Vector3>& positions, const FlockArray<Vector3>& velocities, ThreadPool& threadPool);
+
+    float mSkin;
+    bool mValid;
+
+    SpatialGrid mGrid;                     // Células de tamanho raio + skin, só para o build
+    std::vector<uint32_t> mOffsets;        // Início das faixas de cada boid em mRanges (tamanho N + 1)
+    std::vector<NeighborRange> mRanges;    // Faixas de todos os boids, em sequência
+    std::vector<std::vector<NeighborRange>> mChunkRanges; // Faixas de cada bloco do build (rascunho)
+    std::vector<Vector3> mBuildPositions;  // Posições no último build
+
+    // Cópia SoA do frame atual, na ordem dos slots
+    std::vector<float> mX, mY, mZ;
+    std::vector<float> mVX, mVY, mVZ;
+
+    uint64_t mRebuildCount;
+    uint64_t mFrameCount;
+};
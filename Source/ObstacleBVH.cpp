@@ -0,0 +1,67 @@
+#include "ObstacleBVH.h"
+#include <algorithm>
+
+ObstacleBVH::ObstacleBVH()
+{
+}
+
+void ObstacleBVH::Build(const std::vector<Obstacle>& obstacles, float margin) {
+    mNodes.clear();
+    mObstacles = obstacles;
+    if (mObstacles.empty()) return;
+
+    mNodes.reserve(2 * mObstacles.size() / LeafSize + 1);
+    BuildNode(0, static_cast<uint32_t>(mObstacles.size()), margin);
+}
+
+uint32_t ObstacleBVH::BuildNode(uint32_t start, uint32_t count, float margin) {
+    uint32_t nodeIndex = static_cast<uint32_t>(mNodes.size());
+    mNodes.emplace_back();
+
+    // Caixa das esferas aumentadas pela margem e caixa dos centros (para escolher o corte)
+    Vector3 boxMin(Math::Infinity, Math::Infinity, Math::Infinity);
+    Vector3 boxMax(Math::NegInfinity, Math::NegInfinity, Math::NegInfinity);
+    Vector3 centerMin = boxMin;
+    Vector3 centerMax = boxMax;
+    for (uint32_t i = start; i < start + count; i++) {
+        const Obstacle& obs = mObstacles[i];
+        float r = obs.radius + margin;
+        boxMin = Vector3(Math::Min(boxMin.x, obs.position.x - r), Math::Min(boxMin.y, obs.position.y - r), Math::Min(boxMin.z, obs.position.z - r));
+        boxMax = Vector3(Math::Max(boxMax.x, obs.position.x + r), Math::Max(boxMax.y, obs.position.y + r), Math::Max(boxMax.z, obs.position.z + r));
+        centerMin = Vector3(Math::Min(centerMin.x, obs.position.x), Math::Min(centerMin.y, obs.position.y), Math::Min(centerMin.z, obs.position.z));
+        centerMax = Vector3(Math::Max(centerMax.x, obs.position.x), Math::Max(centerMax.y, obs.position.y), Math::Max(centerMax.z, obs.position.z));
+    }
+
+    mNodes[nodeIndex].min = boxMin;
+    mNodes[nodeIndex].max = boxMax;
+
+    if (count <= LeafSize) {
+        mNodes[nodeIndex].start = start;
+        mNodes[nodeIndex].count = count;
+        mNodes[nodeIndex].rightChild = 0;
+        return nodeIndex;
+    }
+
+    // Corta na mediana do eixo em que os centros estão mais espalhados
+    Vector3 extent = centerMax - centerMin;
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > (axis == 0 ? extent.x : extent.y)) axis = 2;
+
+    auto axisValue = [axis](const Obstacle& obs) {
+        return axis == 0 ? obs.position.x : (axis == 1 ? obs.position.y : obs.position.z);
+    };
+
+    uint32_t half = count / 2;
+    std::nth_element(mObstacles.begin() + start, mObstacles.begin() + start + half, mObstacles.begin() + start + count,
+                     [&](const Obstacle& a, const Obstacle& b) { return axisValue(a) < axisValue(b); });
+
+    // Filho esquerdo logo depois deste nó (pré-ordem); o direito vem depois da subárvore esquerda
+    BuildNode(start, half, margin);
+    uint32_t right = BuildNode(start + half, count - half, margin);
+
+    mNodes[nodeIndex].start = 0;
+    mNodes[nodeIndex].count = 0;
+    mNodes[nodeIndex].rightChild = right;
+    return nodeIndex;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Math.h"
+#include <vector>
+#include <cstdint>
+
+// Definição de obstáculo
+struct Obstacle {
+    Vector3 position;
+    float radius;
+};
+
+// Hierarquia de volumes envolventes (BVH) sobre as esferas de obstáculo.
+// Cada esfera entra com o raio aumentado pela margem de desvio, então a
+// consulta por ponto visita só os obstáculos cuja zona de desvio contém o
+// ponto: O(log M) por boid em vez de percorrer todos os M obstáculos.
+class ObstacleBVH {
+public:
+    // Folhas com até este número de obstáculos
+    static constexpr uint32_t LeafSize = 4;
+
+    ObstacleBVH();
+
+    // Reconstrói a árvore; margin é somada ao raio de cada obstáculo
+    void Build(const std::vector<Obstacle>& obstacles, float margin);
+
+    // Chama fn(obstáculo) para cada obstáculo cuja caixa (raio + margem) contém pos.
+    // Ainda é preciso testar a distância: a caixa é maior que a esfera.
+    template <typename Fn>
+    void ForEachNear(const Vector3& pos, Fn&& fn) const;
+
+    size_t GetNodeCount() const { return mNodes.size(); }
+
+private:
+    struct Node {
+        Vector3 min;
+        Vector3 max;
+        uint32_t start;      // Folha: primeiro obstáculo em mObstacles
+        uint32_t count;      // Folha: quantos obstáculos (0 = nó interno)
+        uint32_t rightChild; // Nó interno: filho direito (o esquerdo é o nó seguinte)
+    };
+
+    uint32_t BuildNode(uint32_t start, uint32_t count, float margin);
+
+    std::vector<Node> mNodes;          // Em pré-ordem, raiz em 0
+    std::vector<Obstacle> mObstacles;  // Cópia reordenada para as folhas ficarem contíguas
+};
+
+template <typename Fn>
+void ObstacleBVH::ForEachNear(const Vector3& pos, Fn&& fn) const {
+    if (mNodes.empty()) return;
+
+    // Pilha explícita: a profundidade é limitada por log2 do número de obstáculos
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node& node = mNodes[stack[--top]];
+
+        if (pos.x < node.min.x || pos.x > node.max.x ||
+            pos.y < node.min.y || pos.y > node.max.y ||
+            pos.z < node.min.z || pos.z > node.max.z) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (uint32_t i = node.start; i < node.start + node.count; i++) {
+                fn(mObstacles[i]);
+            }
+        }
+        else {
+            stack[top++] = node.rightChild;
+            stack[top++] = static_cast<uint32_t>(&node - mNodes.data()) + 1;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+bool Profiler::sEnabled = true;
+double Profiler::sSamples[Profiler::PhaseCount][Profiler::WindowSize];
+size_t Profiler::sCounts[Profiler::PhaseCount];
+
+void Profiler::Record(Phase phase, double ms) {
+    sSamples[phase][sCounts[phase] % WindowSize] = ms;
+    sCounts[phase]++;
+}
+
+Profiler::Stats Profiler::GetStats(Phase phase) {
+    Stats stats = { 0.0, 0.0, 0.0, 0.0, 0 };
+    size_t count = std::min(sCounts[phase], WindowSize);
+    if (count == 0) return stats;
+
+    double sorted[WindowSize];
+    std::copy(sSamples[phase], sSamples[phase] + count, sorted);
+    std::sort(sorted, sorted + count);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += sorted[i];
+    }
+
+    stats.minMs = sorted[0];
+    stats.avgMs = sum / static_cast<double>(count);
+    // Posto mais próximo: com poucas amostras o p99 é o máximo
+    stats.p99Ms = sorted[static_cast<size_t>(std::ceil(count * 0.99)) - 1];
+    stats.maxMs = sorted[count - 1];
+    stats.samples = count;
+    return stats;
+}
+
+const char* Profiler::GetPhaseName(Phase phase) {
+    static const char* names[PhaseCount] = {
+        "update", "update.scenery", "update.sort", "update.neighbors", "update.boids",
+        "update.export", "update.camera", "draw", "draw.scenery", "draw.boids",
+        "draw.shadows", "main.display", "main.update"
+    };
+    return names[phase];
+}
+
+bool Profiler::WriteCsv(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "phase,sample,ms\n");
+    for (int p = 0; p < PhaseCount; p++) {
+        size_t count = std::min(sCounts[p], WindowSize);
+        // Da amostra mais antiga para a mais nova
+        size_t first = sCounts[p] - count;
+        for (size_t i = 0; i < count; i++) {
+            size_t sample = first + i;
+            fprintf(file, "%s,%zu,%.6f\n", GetPhaseName(static_cast<Phase>(p)), sample, sSamples[p][sample % WindowSize]);
+        }
+    }
+
+    return fclose(file) == 0;
+}
+
+void Profiler::Reset() {
+    std::fill(sCounts, sCounts + PhaseCount, size_t(0));
+}
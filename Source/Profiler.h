@@ -0,0 +1,81 @@
+#pragma once
+#include "Tracer.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Tempos por fase do frame (Update, Draw e callbacks do Main), guardados numa
+// janela móvel das últimas amostras de cada fase. Serve para o HUD (min/avg/p99)
+// e para exportar em CSV. Só é chamado da thread principal.
+class Profiler {
+public:
+    enum Phase {
+        UpdateTotal,    // World::Update inteiro
+        UpdateScenery,  // Reconstrução da BVH/campo do cenário
+        UpdateSort,     // Reordenação pela curva de Morton
+        UpdateNeighbors,// Grade espacial ou lista de Verlet
+        UpdateBoids,    // Boid::Update de todo o bando
+        UpdateExport,   // Cópia para a exportação de trajetórias
+        UpdateCamera,   // World::UpdateCamera
+        DrawTotal,      // World::Draw inteiro
+        DrawScenery,    // Chão, torre e obstáculos
+        DrawBoids,      // DrawBirdModel de todos os boids
+        DrawShadows,    // Sombras
+        MainDisplay,    // Callback de desenho do Main (com o swap)
+        MainUpdate,     // Callback de atualização do Main (todos os passos do frame)
+        PhaseCount
+    };
+
+    // Amostras guardadas por fase
+    static constexpr size_t WindowSize = 240;
+
+    struct Stats {
+        double minMs;
+        double avgMs;
+        double p99Ms;
+        double maxMs;
+        size_t samples;
+    };
+
+    static void SetEnabled(bool enabled) { sEnabled = enabled; }
+    static bool IsEnabled() { return sEnabled; }
+
+    static void Record(Phase phase, double ms);
+    static Stats GetStats(Phase phase);
+    static const char* GetPhaseName(Phase phase);
+
+    // Todas as amostras da janela, uma linha por amostra (phase,sample,ms)
+    static bool WriteCsv(const char* path);
+
+    static void Reset();
+
+private:
+    static bool sEnabled;
+    static double sSamples[PhaseCount][WindowSize];
+    static size_t sCounts[PhaseCount]; // Total já gravado (a posição na janela é count % WindowSize)
+};
+
+// Mede o tempo do escopo e grava na fase ao sair (e no Tracer, se estiver ligado)
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Profiler::Phase phase)
+        :mPhase(phase)
+        ,mTrace(Profiler::GetPhaseName(phase))
+        ,mStart(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedTimer() {
+        if (Profiler::IsEnabled()) {
+            Profiler::Record(mPhase, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mStart).count());
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Profiler::Phase mPhase;
+    TraceScope mTrace;
+    std::chrono::steady_clock::time_point mStart;
+};
@@ -7,45 +7,146 @@
 // ----------------------------------------------------------------
 
 #include "Random.h"
+#include <atomic>
+#include <random>
 
-void Random::Init()
+namespace
+{
+	uint64_t SplitMix64(uint64_t& state)
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	uint64_t sMasterSeed = 0;
+	// Bumped by Seed so other threads pick up the new master seed
+	std::atomic<uint32_t> sEpoch(0);
+	std::atomic<uint64_t> sNextStream(1);
+
+	struct ThreadStream
+	{
+		RandomStream stream;
+		uint32_t epoch = UINT32_MAX;
+	};
+	thread_local ThreadStream tStream;
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t streamIndex)
+{
+	// Mix the stream index into the seed, then expand to 128 bits of state
+	uint64_t sm = seed;
+	uint64_t key = SplitMix64(sm) ^ (streamIndex * 0xD1B54A32D192ED03ull);
+	uint64_t a = SplitMix64(key);
+	uint64_t b = SplitMix64(key);
+	mState[0] = static_cast<uint32_t>(a);
+	mState[1] = static_cast<uint32_t>(a >> 32);
+	mState[2] = static_cast<uint32_t>(b);
+	mState[3] = static_cast<uint32_t>(b >> 32);
+	// All-zero state never leaves zero
+	if ((mState[0] | mState[1] | mState[2] | mState[3]) == 0)
+	{
+		mState[0] = 1;
+	}
+}
+
+void RandomStream::FillFloats(float* out, size_t count, float min, float max)
+{
+	const float scale = (max - min) * (1.0f / 16777216.0f);
+	for (size_t i = 0; i < count; i++)
+	{
+		out[i] = min + static_cast<float>(Next() >> 8) * scale;
+	}
+}
+
+void RandomStream::FillVectors(Vector3* out, size_t count, const Vector3& min, const Vector3& max)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		out[i] = GetVector(min, max);
+	}
+}
+
+unsigned int Random::Init()
 {
 	std::random_device rd;
-	Random::Seed(rd());
+	unsigned int seed = rd();
+	Random::Seed(seed);
+	return seed;
 }
 
 void Random::Seed(unsigned int seed)
 {
-	sGenerator.seed(seed);
+	sMasterSeed = seed;
+	sNextStream.store(1, std::memory_order_relaxed);
+	uint32_t epoch = sEpoch.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	tStream.stream = RandomStream(sMasterSeed, 0);
+	tStream.epoch = epoch;
+}
+
+Random::State Random::GetState()
+{
+	State state;
+	state.masterSeed = sMasterSeed;
+	state.nextStream = sNextStream.load(std::memory_order_relaxed);
+	GetThreadStream().GetState(state.stream);
+	return state;
+}
+
+void Random::SetState(const State& state)
+{
+	sMasterSeed = state.masterSeed;
+	sNextStream.store(state.nextStream, std::memory_order_relaxed);
+	uint32_t epoch = sEpoch.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	tStream.stream.SetState(state.stream);
+	tStream.epoch = epoch;
+}
+
+RandomStream& Random::GetThreadStream()
+{
+	uint32_t epoch = sEpoch.load(std::memory_order_relaxed);
+	if (tStream.epoch != epoch)
+	{
+		tStream.stream = RandomStream(sMasterSeed, sNextStream.fetch_add(1, std::memory_order_relaxed));
+		tStream.epoch = epoch;
+	}
+	return tStream.stream;
+}
+
+RandomStream Random::MakeStream(uint64_t streamIndex)
+{
+	return RandomStream(sMasterSeed, streamIndex);
 }
 
 float Random::GetFloat()
 {
-	return GetFloatRange(0.0f, 1.0f);
+	return GetThreadStream().GetFloat();
 }
 
 float Random::GetFloatRange(float min, float max)
 {
-	std::uniform_real_distribution<float> dist(min, max);
-	return dist(sGenerator);
+	return GetThreadStream().GetFloatRange(min, max);
 }
 
 int Random::GetIntRange(int min, int max)
 {
-	std::uniform_int_distribution<int> dist(min, max);
-	return dist(sGenerator);
+	return GetThreadStream().GetIntRange(min, max);
+}
+
+Vector3 Random::GetVector(const Vector3& min, const Vector3& max)
+{
+	return GetThreadStream().GetVector(min, max);
 }
 
-// Vector2 Random::GetVector(const Vector2& min, const Vector2& max)
-// {
-// 	Vector2 r = Vector2(GetFloat(), GetFloat());
-// 	return min + (max - min) * r;
-// }
-//
-// Vector3 Random::GetVector(const Vector3& min, const Vector3& max)
-// {
-// 	Vector3 r = Vector3(GetFloat(), GetFloat(), GetFloat());
-// 	return min + (max - min) * r;
-// }
+void Random::FillFloats(float* out, size_t count, float min, float max)
+{
+	GetThreadStream().FillFloats(out, count, min, max);
+}
 
-std::mt19937 Random::sGenerator;
+void Random::FillVectors(Vector3* out, size_t count, const Vector3& min, const Vector3& max)
+{
+	GetThreadStream().FillVectors(out, count, min, max);
+}
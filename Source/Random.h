@@ -7,16 +7,85 @@
 // ----------------------------------------------------------------
 
 #pragma  once
-#include <random>
-// #include "Math.h"
+#include <cstddef>
+#include <cstdint>
+#include "Math.h"
 
+// One xoshiro128+ generator. Streams built from the same (seed, index)
+// produce the same sequence on every platform; different indices give
+// independent sequences (the state is expanded with splitmix64).
+class RandomStream
+{
+public:
+	RandomStream() : RandomStream(0, 0) {}
+	RandomStream(uint64_t seed, uint64_t streamIndex);
+
+	// Next raw 32-bit value
+	uint32_t Next()
+	{
+		const uint32_t result = mState[0] + mState[3];
+		const uint32_t t = mState[1] << 9;
+		mState[2] ^= mState[0];
+		mState[3] ^= mState[1];
+		mState[1] ^= mState[2];
+		mState[0] ^= mState[3];
+		mState[2] ^= t;
+		mState[3] = (mState[3] << 11) | (mState[3] >> 21);
+		return result;
+	}
+
+	// Float in [0, 1) from the top 24 bits (the low bits of xoshiro128+ are weaker)
+	float GetFloat() { return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+
+	float GetFloatRange(float min, float max) { return min + (max - min) * GetFloat(); }
+
+	// Int in [min, max] (multiply-shift, no modulo)
+	int GetIntRange(int min, int max)
+	{
+		uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+		return static_cast<int>(min + static_cast<int64_t>((Next() * range) >> 32));
+	}
+
+	Vector3 GetVector(const Vector3& min, const Vector3& max)
+	{
+		float x = GetFloatRange(min.x, max.x);
+		float y = GetFloatRange(min.y, max.y);
+		float z = GetFloatRange(min.z, max.z);
+		return Vector3(x, y, z);
+	}
+
+	// Bulk versions: same values as calling GetFloatRange / GetVector in a loop
+	void FillFloats(float* out, size_t count, float min, float max);
+	void FillVectors(Vector3* out, size_t count, const Vector3& min, const Vector3& max);
+
+	// Raw generator state, to save and resume a stream exactly
+	void GetState(uint32_t state[4]) const
+	{
+		for (int i = 0; i < 4; i++) state[i] = mState[i];
+	}
+
+	void SetState(const uint32_t state[4])
+	{
+		for (int i = 0; i < 4; i++) mState[i] = state[i];
+	}
+
+private:
+	uint32_t mState[4];
+};
+
+// Static interface over one RandomStream per thread. All streams derive from
+// the master seed: the thread that calls Seed gets stream 0, other threads get
+// the next unused index the first time they draw after a Seed. For parallel
+// work that must be reproducible regardless of which thread runs it, use
+// MakeStream with an index tied to the work (e.g. the block number) instead.
 class Random
 {
 public:
-	static void Init();
+	// Seed from std::random_device; returns the seed so a run can be recorded
+	static unsigned int Init();
 
-	// Seed the generator with the specified int
-	// NOTE: You should generally not need to manually use this
+	// Set the master seed and restart the calling thread at stream 0.
+	// Call it while no other thread is drawing numbers.
 	static void Seed(unsigned int seed);
 
 	// Get a float between 0.0f and 1.0f
@@ -29,8 +98,29 @@ public:
 	static int GetIntRange(int min, int max);
 
 	// Get a random vector given the min/max bounds
-	// static Vector2 GetVector(const Vector2& min, const Vector2& max);
-	// static Vector3 GetVector(const Vector3& min, const Vector3& max);
-private:
-	static std::mt19937 sGenerator;
+	static Vector3 GetVector(const Vector3& min, const Vector3& max);
+
+	// Fill arrays from the calling thread's stream
+	static void FillFloats(float* out, size_t count, float min, float max);
+	static void FillVectors(Vector3* out, size_t count, const Vector3& min, const Vector3& max);
+
+	// Independent stream streamIndex of the current master seed
+	static RandomStream MakeStream(uint64_t streamIndex);
+
+	// The calling thread's stream
+	static RandomStream& GetThreadStream();
+
+	// Everything needed to continue the sequence of the calling thread
+	// (and to hand out the same indices to other threads) after a restore
+	struct State
+	{
+		uint64_t masterSeed;
+		uint64_t nextStream;
+		uint32_t stream[4];
+	};
+
+	static State GetState();
+
+	// Like Seed, but resumes where GetState was taken instead of at the start
+	static void SetState(const State& state);
 };
@@ -0,0 +1,173 @@
+#include "Recording.h"
+#include "World.h"
+#include "NeighborKernel.h"
+#include <cstring>
+#include <type_traits>
+
+static const char kRecordMagic[8] = { 'B', 'O', 'I', 'D', 'S', 'R', 'E', 'C' };
+
+// Muda sempre que o formato ou a simulação mudarem de um jeito que quebre gravações antigas
+// 2: Random passou de mt19937 para xoshiro128+ (mesma semente, outra sequência)
+// 3: o bando inicial do Init vem do World::SpawnFlock (um stream por bloco de slots)
+// 4: campo flags com a política de Math::Hot da build
+// 5: SceneryField usa o cálculo analítico nas células com descontinuidade
+// 6: o LOD reveza os boids de cada faixa pelo id, não pelo slot
+// 7: SceneryField virou um campo de distância com sinal (desvio pela distância e gradiente)
+static const uint32_t kRecordVersion = 7;
+
+// Flags desta build
+static const uint32_t kRecordBuildFlags = Math::IsFastMath ? RecordFastMath : 0u;
+
+static_assert(std::is_trivially_copyable<RecordHeader>::value, "RecordHeader é gravado com fwrite");
+static_assert(sizeof(RecordHeader) == 56, "layout do RecordHeader mudou: suba kRecordVersion");
+static_assert(sizeof(KeyMask) == 32, "KeyMask tem 256 bits");
+
+RecordHeader RecordHeader::Capture(const World& world, int boidCount, int extraObstacles, float deltaTime) {
+    RecordHeader header;
+    memcpy(header.magic, kRecordMagic, sizeof(kRecordMagic));
+    header.version = kRecordVersion;
+    header.seed = world.GetSeed();
+    header.boidCount = static_cast<uint32_t>(boidCount);
+    header.extraObstacles = static_cast<uint32_t>(extraObstacles);
+    header.sortInterval = world.GetSortInterval();
+    header.isa = static_cast<uint32_t>(NeighborKernel::GetIsa());
+    header.flags = kRecordBuildFlags;
+    header.deltaTime = deltaTime;
+    header.verletSkin = world.GetNeighborList().GetSkin();
+    for (int i = 0; i < 3; i++) {
+        header.lodDistances[i] = world.GetLodDistance(i);
+    }
+    return header;
+}
+
+void RecordHeader::Apply(World& world) const {
+    world.SetSeed(seed);
+    world.SetSortInterval(sortInterval);
+    world.SetNeighborListSkin(verletSkin);
+    world.SetLodDistances(lodDistances[0], lodDistances[1], lodDistances[2]);
+
+    NeighborKernel::Isa recorded = static_cast<NeighborKernel::Isa>(isa);
+    NeighborKernel::SetIsa(recorded);
+    if (NeighborKernel::GetIsa() != recorded) {
+        fprintf(stderr, "Aviso: gravação feita com o kernel %s, esta CPU usa %s; o resultado pode divergir\n",
+                NeighborKernel::GetIsaName(recorded), NeighborKernel::GetIsaName(NeighborKernel::GetIsa()));
+    }
+}
+
+KeyMask KeyMask::FromKeyStates(const std::map<unsigned char, bool>& keyStates) {
+    KeyMask mask = {};
+    for (const auto& entry : keyStates) {
+        if (entry.second) {
+            mask.bits[entry.first >> 6] |= uint64_t(1) << (entry.first & 63);
+        }
+    }
+    return mask;
+}
+
+void KeyMask::ToKeyStates(std::map<unsigned char, bool>& keyStates) const {
+    keyStates.clear();
+    for (int key = 0; key < 256; key++) {
+        if (bits[key >> 6] & (uint64_t(1) << (key & 63))) {
+            keyStates[static_cast<unsigned char>(key)] = true;
+        }
+    }
+}
+
+Recorder::Recorder()
+    :mFile(nullptr)
+    ,mFrameCount(0)
+{
+}
+
+Recorder::~Recorder() {
+    Close();
+}
+
+bool Recorder::Open(const char* path, const RecordHeader& header) {
+    Close();
+    mFile = fopen(path, "wb");
+    if (!mFile) return false;
+
+    if (fwrite(&header, sizeof(header), 1, mFile) != 1) {
+        Close();
+        return false;
+    }
+    mFrameCount = 0;
+    return true;
+}
+
+void Recorder::WriteFrame(const std::map<unsigned char, bool>& keyStates) {
+    if (!mFile) return;
+
+    KeyMask mask = KeyMask::FromKeyStates(keyStates);
+    fwrite(&mask, sizeof(mask), 1, mFile);
+    mFrameCount++;
+}
+
+void Recorder::Close() {
+    if (mFile) {
+        fclose(mFile);
+        mFile = nullptr;
+    }
+}
+
+Replayer::Replayer()
+    :mFile(nullptr)
+    ,mHeader()
+    ,mFrameCount(0)
+{
+}
+
+Replayer::~Replayer() {
+    Close();
+}
+
+bool Replayer::Open(const char* path) {
+    Close();
+    mFile = fopen(path, "rb");
+    if (!mFile) return false;
+
+    if (fread(&mHeader, sizeof(mHeader), 1, mFile) != 1 ||
+        memcmp(mHeader.magic, kRecordMagic, sizeof(kRecordMagic)) != 0 ||
+        mHeader.version != kRecordVersion) {
+        Close();
+        return false;
+    }
+
+    // Math::Hot é escolhido na compilação: não há como reproduzir com a outra política
+    if ((mHeader.flags & RecordFastMath) != (kRecordBuildFlags & RecordFastMath)) {
+        fprintf(stderr, "Gravação feita com BOIDS_FAST_MATH %s, esta build usa %s\n",
+                (mHeader.flags & RecordFastMath) ? "ligado" : "desligado",
+                Math::IsFastMath ? "ligado" : "desligado");
+        Close();
+        return false;
+    }
+
+    // Quantos passos há: o resto do arquivo é uma sequência de KeyMask
+    long start = ftell(mFile);
+    fseek(mFile, 0, SEEK_END);
+    long end = ftell(mFile);
+    fseek(mFile, start, SEEK_SET);
+    mFrameCount = static_cast<uint64_t>(end - start) / sizeof(KeyMask);
+    return true;
+}
+
+bool Replayer::ReadFrame(std::map<unsigned char, bool>& keyStates) {
+    if (!mFile || mFrameCount == 0) return false;
+
+    KeyMask mask;
+    if (fread(&mask, sizeof(mask), 1, mFile) != 1) {
+        mFrameCount = 0;
+        return false;
+    }
+    mask.ToKeyStates(keyStates);
+    mFrameCount--;
+    return true;
+}
+
+void Replayer::Close() {
+    if (mFile) {
+        fclose(mFile);
+        mFile = nullptr;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <map>
+
+class World;
+
+// Gravação e reprodução de uma execução: a semente do Random, a configuração
+// que muda o resultado da simulação e o estado do teclado de cada passo.
+// Com a mesma gravação, o boids e o boids_headless refazem a execução bit a bit
+// (o Update não depende da ordem das threads, então o número de threads é livre).
+//
+// Formato (binário, little-endian): RecordHeader seguido de um KeyMask por passo.
+
+// Opções de compilação que mudam o resultado da simulação
+enum RecordFlags : uint32_t {
+    RecordFastMath = 1u << 0 // BOIDS_FAST_MATH (Math::Hot aproximado)
+};
+
+// Cabeçalho do arquivo
+struct RecordHeader {
+    char magic[8];            // "BOIDSREC"
+    uint32_t version;
+    uint32_t seed;            // Semente do Random
+    uint32_t boidCount;       // Argumento do World::Init
+    uint32_t extraObstacles;  // World::AddRandomObstacles depois do Init
+    int32_t sortInterval;
+    uint32_t isa;             // NeighborKernel::Isa (os kernels arredondam diferente)
+    uint32_t flags;           // RecordFlags da build que gravou
+    float deltaTime;          // Passo fixo
+    float verletSkin;
+    float lodDistances[3];
+
+    // Preenche com a configuração atual do world (a semente já precisa estar definida)
+    static RecordHeader Capture(const World& world, int boidCount, int extraObstacles, float deltaTime);
+
+    // Aplica a configuração ao world antes do Init (semente, ordenação, skin, LOD, ISA)
+    void Apply(World& world) const;
+};
+
+// Estado do teclado num passo: um bit por tecla (256 teclas = 32 bytes)
+struct KeyMask {
+    uint64_t bits[4];
+
+    static KeyMask FromKeyStates(const std::map<unsigned char, bool>& keyStates);
+    void ToKeyStates(std::map<unsigned char, bool>& keyStates) const;
+};
+
+// Grava o cabeçalho e um KeyMask por passo
+class Recorder {
+public:
+    Recorder();
+    ~Recorder();
+
+    bool Open(const char* path, const RecordHeader& header);
+    bool IsOpen() const { return mFile != nullptr; }
+    void WriteFrame(const std::map<unsigned char, bool>& keyStates);
+    void Close();
+
+    uint64_t GetFrameCount() const { return mFrameCount; }
+
+private:
+    FILE* mFile;
+    uint64_t mFrameCount;
+};
+
+// Lê uma gravação; ReadFrame devolve false no fim do arquivo
+class Replayer {
+public:
+    Replayer();
+    ~Replayer();
+
+    // Falha se o arquivo não existir, não for uma gravação ou for de outra versão
+    bool Open(const char* path);
+    bool IsOpen() const { return mFile != nullptr; }
+    const RecordHeader& GetHeader() const { return mHeader; }
+    bool ReadFrame(std::map<unsigned char, bool>& keyStates);
+    void Close();
+
+    // Passos restantes no arquivo
+    uint64_t GetFrameCount() const { return mFrameCount; }
+
+private:
+    FILE* mFile;
+    RecordHeader mHeader;
+    uint64_t mFrameCount;
+};
@@ -0,0 +1,224 @@
+#include "SceneryField.h"
+#include "Boid.h"
+#include "ThreadPool.h"
+#include <cmath>
+
+// Peso do desvio em cima da superfície; no meio da margem vale 5, o peso que as esferas tinham
+static const float avoidWeight = 10.0f;
+static const float floorWeight = 8.0f; // Peso ALTO para evitar o chão
+
+// Se estiver abaixo de Y = 15, o chão começa a empurrar para cima
+static const float floorThreshold = 15.0f;
+
+// A torre está em (0,0,0), Radius Base = 3, Altura = 20 (definido no WorldDraw.cpp)
+static const float tBaseRadius = 3.0f;
+static const float tHeight = 20.0f;
+
+// Escala do mínimo suave onde as zonas de desvio se sobrepõem
+static const float blendDistance = 1.0f;
+
+SceneryField::SceneryField()
+    :mMin(Vector3::Zero)
+    ,mMax(Vector3::Zero)
+    ,mCellSize(DefaultCellSize)
+    ,mInvCellSize(1.0f / DefaultCellSize)
+    ,mDimX(0)
+    ,mDimY(0)
+    ,mDimZ(0)
+{
+}
+
+Vector3 SceneryField::FloorForce(float y) {
+    if (y < floorThreshold) {
+        float ratio = (floorThreshold - y) / floorThreshold;
+        // ratio * ratio cria uma curva exponencial: fraco longe, muito forte perto
+        return Vector3(0, 1, 0) * (ratio * ratio * floorWeight);
+    }
+    return Vector3::Zero;
+}
+
+Vector3 SceneryField::AvoidanceForce(float distance, const Vector3& gradient) {
+    // Zero a ObstacleMargin da superfície, peso cheio em cima dela (e mais dentro do sólido)
+    float strength = (Boid::ObstacleMargin - distance) / Boid::ObstacleMargin;
+    if (strength <= 0.0f) return Vector3::Zero;
+    return gradient * (strength * avoidWeight);
+}
+
+// Distância com sinal até o cone da torre: o sólido de revolução do triângulo
+// (0, 0), (tBaseRadius, 0), (0, tHeight) no plano (distância ao eixo, altura)
+static float TowerDistance(const Vector3& pos, Vector3& gradient) {
+    float r = sqrtf(pos.x * pos.x + pos.z * pos.z);
+
+    // Ponto mais próximo na base (y = 0, r em [0, tBaseRadius])
+    float baseR = r - Math::Min(r, tBaseRadius);
+    float baseY = pos.y;
+    float baseSq = baseR * baseR + baseY * baseY;
+
+    // Ponto mais próximo na lateral, de (tBaseRadius, 0) a (0, tHeight)
+    float t = ((tBaseRadius - r) * tBaseRadius + pos.y * tHeight) / (tBaseRadius * tBaseRadius + tHeight * tHeight);
+    t = Math::Clamp(t, 0.0f, 1.0f);
+    float sideR = r - tBaseRadius * (1.0f - t);
+    float sideY = pos.y - tHeight * t;
+    float sideSq = sideR * sideR + sideY * sideY;
+
+    float dr = (baseSq < sideSq) ? baseR : sideR;
+    float dy = (baseSq < sideSq) ? baseY : sideY;
+    float dist = sqrtf(Math::Min(baseSq, sideSq));
+
+    // Gradiente no plano: do ponto mais próximo para fora (em cima da
+    // superfície, a normal da lateral)
+    float gr = tHeight;
+    float gy = tBaseRadius;
+    if (dist > 0.0001f) {
+        gr = dr / dist;
+        gy = dy / dist;
+    }
+    else {
+        float length = sqrtf(gr * gr + gy * gy);
+        gr /= length;
+        gy /= length;
+    }
+
+    bool inside = pos.y > 0.0f && r < tBaseRadius * (1.0f - pos.y / tHeight);
+    if (inside) {
+        dist = -dist;
+        gr = -gr;
+        gy = -gy;
+    }
+
+    // De volta ao 3D: a componente radial aponta para fora do eixo Y
+    Vector3 radial = (r > 0.0001f) ? Vector3(pos.x / r, 0.0f, pos.z / r) : Vector3(1, 0, 0);
+    gradient = radial * gr + Vector3(0.0f, gy, 0.0f);
+    return dist;
+}
+
+SceneryField::Node SceneryField::EvaluateDistance(const Vector3& pos, const ObstacleBVH& bvh) {
+    // Mínimo suave das distâncias: com uma superfície só a menos da margem é a
+    // distância exata; com várias, as zonas se fundem sem a crista onde o
+    // gradiente viraria de direção. Cada superfície pesa exp((margem - d) / k) - 1,
+    // que some na borda da margem (a superfície entra e sai sem salto).
+    const float margin = Boid::ObstacleMargin;
+    float sum = 1.0f;
+    Vector3 gradientSum = Vector3::Zero;
+    auto add = [&](float dist, const Vector3& gradient) {
+        if (dist >= margin) return;
+        float weight = expf((margin - dist) / blendDistance);
+        sum += weight - 1.0f;
+        gradientSum += gradient * weight;
+    };
+
+    Vector3 towerGradient;
+    float towerDist = TowerDistance(pos, towerGradient);
+    add(towerDist, towerGradient);
+
+    // A bvh tem as esferas com a margem somada: visita todas a menos da margem
+    bvh.ForEachNear(pos, [&](const Obstacle& obs) {
+        Vector3 offset = pos - obs.position;
+        float distToCenter = offset.Length();
+        // No centro exato qualquer direção serve
+        Vector3 gradient = (distToCenter > 0.0001f) ? offset * (1.0f / distToCenter) : Vector3(1, 0, 0);
+        add(distToCenter - obs.radius, gradient);
+    });
+
+    // Além da margem a distância fica limitada a ela e o gradiente é zero
+    return { margin - blendDistance * logf(sum), gradientSum * (1.0f / sum) };
+}
+
+Vector3 SceneryField::EvaluateForce(const Vector3& position, const ObstacleBVH& bvh) {
+    Node nearest = EvaluateDistance(position, bvh);
+    return AvoidanceForce(nearest.distance, nearest.gradient) + FloorForce(position.y);
+}
+
+void SceneryField::Bake(const std::vector<Obstacle>& obstacles, const ObstacleBVH& bvh, ThreadPool& threadPool) {
+    // Região onde torre e obstáculos têm efeito, com uma célula de folga
+    // para os nós da borda já terem força zero (fora só resta o chão)
+    const float margin = Boid::ObstacleMargin;
+    mMin = Vector3(-(tBaseRadius + margin), -margin, -(tBaseRadius + margin));
+    mMax = Vector3(tBaseRadius + margin, tHeight + margin, tBaseRadius + margin);
+    for (const Obstacle& obs : obstacles) {
+        float r = obs.radius + margin;
+        mMin = Vector3(Math::Min(mMin.x, obs.position.x - r), Math::Min(mMin.y, obs.position.y - r), Math::Min(mMin.z, obs.position.z - r));
+        mMax = Vector3(Math::Max(mMax.x, obs.position.x + r), Math::Max(mMax.y, obs.position.y + r), Math::Max(mMax.z, obs.position.z + r));
+    }
+
+    // Espaçamento: o padrão, ou maior se a cena não couber em MaxNodes
+    mCellSize = DefaultCellSize;
+    Vector3 extent = mMax - mMin;
+    for (;;) {
+        mDimX = static_cast<int>(ceilf(extent.x / mCellSize)) + 3;
+        mDimY = static_cast<int>(ceilf(extent.y / mCellSize)) + 3;
+        mDimZ = static_cast<int>(ceilf(extent.z / mCellSize)) + 3;
+        if (static_cast<size_t>(mDimX) * mDimY * mDimZ <= MaxNodes) break;
+        mCellSize *= 1.25f;
+    }
+    mInvCellSize = 1.0f / mCellSize;
+    mMin -= Vector3(mCellSize, mCellSize, mCellSize);
+    mMax = mMin + Vector3(static_cast<float>(mDimX - 1), static_cast<float>(mDimY - 1), static_cast<float>(mDimZ - 1)) * mCellSize;
+
+    // Cada fatia XY é independente: preenche em paralelo
+    mNodes.resize(static_cast<size_t>(mDimX) * mDimY * mDimZ);
+    threadPool.ParallelFor(static_cast<size_t>(mDimZ), 1, [&](size_t begin, size_t end) {
+        for (size_t z = begin; z < end; z++) {
+            for (int y = 0; y < mDimY; y++) {
+                for (int x = 0; x < mDimX; x++) {
+                    Vector3 p = mMin + Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) * mCellSize;
+                    mNodes[(z * mDimY + y) * mDimX + x] = EvaluateDistance(p, bvh);
+                }
+            }
+        }
+    }, "scenery.bake");
+}
+
+bool SceneryField::Locate(const Vector3& pos, size_t& base, Vector3& t) const {
+    if (mNodes.empty() ||
+        pos.x < mMin.x || pos.y < mMin.y || pos.z < mMin.z ||
+        pos.x >= mMax.x || pos.y >= mMax.y || pos.z >= mMax.z) {
+        return false;
+    }
+
+    Vector3 g = (pos - mMin) * mInvCellSize;
+    int x = Math::Min(static_cast<int>(g.x), mDimX - 2);
+    int y = Math::Min(static_cast<int>(g.y), mDimY - 2);
+    int z = Math::Min(static_cast<int>(g.z), mDimZ - 2);
+    t = Vector3(g.x - x, g.y - y, g.z - z);
+    base = (static_cast<size_t>(z) * mDimY + y) * mDimX + x;
+    return true;
+}
+
+Vector3 SceneryField::SampleForce(const Vector3& pos) const {
+    size_t base;
+    Vector3 t;
+    if (!Locate(pos, base, t)) {
+        return FloorForce(pos.y);
+    }
+
+    const size_t dy = static_cast<size_t>(mDimX);
+    const size_t dz = static_cast<size_t>(mDimX) * mDimY;
+    const Node& n000 = mNodes[base];
+    const Node& n100 = mNodes[base + 1];
+    const Node& n010 = mNodes[base + dy];
+    const Node& n110 = mNodes[base + dy + 1];
+    const Node& n001 = mNodes[base + dz];
+    const Node& n101 = mNodes[base + dz + 1];
+    const Node& n011 = mNodes[base + dz + dy];
+    const Node& n111 = mNodes[base + dz + dy + 1];
+
+    float d00 = Math::Lerp(n000.distance, n100.distance, t.x);
+    float d10 = Math::Lerp(n010.distance, n110.distance, t.x);
+    float d01 = Math::Lerp(n001.distance, n101.distance, t.x);
+    float d11 = Math::Lerp(n011.distance, n111.distance, t.x);
+    float distance = Math::Lerp(Math::Lerp(d00, d10, t.y), Math::Lerp(d01, d11, t.y), t.z);
+
+    // Longe de tudo (o caso comum) nem interpola o gradiente
+    if (distance >= Boid::ObstacleMargin) {
+        return FloorForce(pos.y);
+    }
+
+    Vector3 g00 = Vector3::Lerp(n000.gradient, n100.gradient, t.x);
+    Vector3 g10 = Vector3::Lerp(n010.gradient, n110.gradient, t.x);
+    Vector3 g01 = Vector3::Lerp(n001.gradient, n101.gradient, t.x);
+    Vector3 g11 = Vector3::Lerp(n011.gradient, n111.gradient, t.x);
+    Vector3 gradient = Vector3::Lerp(Vector3::Lerp(g00, g10, t.y), Vector3::Lerp(g01, g11, t.y), t.z);
+
+    return AvoidanceForce(distance, gradient) + FloorForce(pos.y);
+}
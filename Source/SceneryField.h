@@ -0,0 +1,71 @@
+#pragma once
+#include "Math.h"
+#include "ObstacleBVH.h"
+#include <vector>
+
+class ThreadPool;
+
+// Campo de distância com sinal (SDF) pré-calculado do cenário estático (torre
+// e esferas de obstáculo). Cada nó da grade guarda a distância até a superfície
+// sólida mais próxima e o gradiente dela (a direção que se afasta da
+// superfície); o boid obtém todo o desvio estático de uma única interpolação
+// trilinear, sem depender de quantos obstáculos há na cena.
+//
+// O desvio é uma função só da distância: cresce linearmente de zero, a
+// Boid::ObstacleMargin da superfície, até o peso cheio em cima dela, sempre ao
+// longo do gradiente. Onde as zonas de desvio de várias superfícies se
+// sobrepõem a distância é um mínimo suave, então distância e gradiente são
+// contínuos fora dos sólidos e a interpolação não precisa de casos especiais.
+//
+// O chão fica fora do campo: é um plano, e a força dele depende só da altura.
+// Fora da grade (longe da torre e dos obstáculos) só resta a força do chão.
+class SceneryField {
+public:
+    // Espaçamento padrão entre nós e limite de nós da grade (cresce o espaçamento se passar)
+    static constexpr float DefaultCellSize = 1.0f;
+    static constexpr size_t MaxNodes = size_t(1) << 21;
+
+    SceneryField();
+
+    // Limite da diferença entre SampleForce e EvaluateForce no percentil 99
+    // das consultas fora dos sólidos (conferido no boids_bench; 10% do peso do
+    // desvio). O erro máximo fica dentro das esferas e da torre, onde o
+    // gradiente gira em torno do centro ou do eixo.
+    static constexpr float MaxInterpolationError = 1.0f;
+
+    // Amostra a cena em todos os nós (em paralelo). Chamado quando os obstáculos mudam.
+    // A bvh só é consultada durante o Bake.
+    void Bake(const std::vector<Obstacle>& obstacles, const ObstacleBVH& bvh, ThreadPool& threadPool);
+
+    // Força de desvio de todo o cenário estático em pos
+    Vector3 SampleForce(const Vector3& pos) const;
+
+    // Cálculo analítico de referência, com a mesma SDF usada para preencher os nós
+    static Vector3 EvaluateForce(const Vector3& pos, const ObstacleBVH& bvh);
+
+    float GetCellSize() const { return mCellSize; }
+    size_t GetNodeCount() const { return mNodes.size(); }
+
+private:
+    struct Node {
+        float distance;   // Até a superfície mais próxima, limitada a Boid::ObstacleMargin
+        Vector3 gradient; // Unitário, ou zero sem superfície a menos da margem
+    };
+
+    // Acha a célula de pos e os pesos trilineares; false se pos está fora da grade
+    bool Locate(const Vector3& pos, size_t& base, Vector3& t) const;
+
+    static Vector3 FloorForce(float y);
+    static Vector3 AvoidanceForce(float distance, const Vector3& gradient);
+
+    // SDF da torre e das esferas em pos (a bvh é a das zonas de desvio)
+    static Node EvaluateDistance(const Vector3& pos, const ObstacleBVH& bvh);
+
+    Vector3 mMin;
+    Vector3 mMax;
+    float mCellSize;
+    float mInvCellSize;
+    int mDimX, mDimY, mDimZ;
+
+    std::vector<Node> mNodes; // x varia mais rápido, depois y, depois z
+};
@@ -0,0 +1,79 @@
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(float cellSize)
+    :mCellSize(cellSize)
+    ,mInvCellSize(1.0f / cellSize)
+    ,mTableMask(0)
+{
+}
+
+void SpatialGrid::SetCellSize(float cellSize) {
+    mCellSize = cellSize;
+    mInvCellSize = 1.0f / cellSize;
+}
+
+void SpatialGrid::Build(const FlockArray<Vector3>& positions) {
+    const size_t count = positions.size();
+
+    // Tabela com pelo menos 2x mais baldes que boids (potência de 2) para manter poucas colisões
+    uint32_t tableSize = 64;
+    while (tableSize < count * 2) tableSize <<= 1;
+    mTableMask = tableSize - 1;
+
+    // Counting sort dos boids por balde
+    mCellStart.assign(tableSize + 1, 0);
+    mBoidHash.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        const Vector3& p = positions[i];
+        uint32_t h = HashCell(CellCoord(p.x), CellCoord(p.y), CellCoord(p.z));
+        mBoidHash[i] = h;
+        mCellStart[h + 1]++;
+    }
+
+    for (uint32_t h = 0; h < tableSize; h++) {
+        mCellStart[h + 1] += mCellStart[h];
+    }
+
+    mCursor.assign(mCellStart.begin(), mCellStart.end() - 1);
+    mEntries.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        mEntries[mCursor[mBoidHash[i]]++] = static_cast<uint32_t>(i);
+    }
+}
+
+void SpatialGrid::Build(const FlockArray<Vector3>& positions, const FlockArray<Vector3>& velocities) {
+    Build(positions);
+    const size_t count = positions.size();
+
+    // Cópia SoA ordenada, com folga no fim para o kernel poder ler blocos inteiros
+    const size_t padded = count + NeighborKernel::Padding;
+    mSortedX.resize(padded, 0.0f);
+    mSortedY.resize(padded, 0.0f);
+    mSortedZ.resize(padded, 0.0f);
+    mSortedVX.resize(padded, 0.0f);
+    mSortedVY.resize(padded, 0.0f);
+    mSortedVZ.resize(padded, 0.0f);
+    for (size_t e = 0; e < count; e++) {
+        const Vector3& p = positions[mEntries[e]];
+        const Vector3& v = velocities[mEntries[e]];
+        mSortedX[e] = p.x;
+        mSortedY[e] = p.y;
+        mSortedZ[e] = p.z;
+        mSortedVX[e] = v.x;
+        mSortedVY[e] = v.y;
+        mSortedVZ[e] = v.z;
+    }
+}
+
+int SpatialGrid::GatherCandidateRanges(const Vector3& pos, NeighborRange ranges[MaxRanges]) const {
+    int rangeCount = 0;
+    ForEachBucket(pos, [&](uint32_t begin, uint32_t end) {
+        ranges[rangeCount++] = { begin, end };
+    });
+    return rangeCount;
+}
+
+NeighborArrays SpatialGrid::GetSortedArrays() const {
+    return { mSortedX.data(), mSortedY.data(), mSortedZ.data(),
+             mSortedVX.data(), mSortedVY.data(), mSortedVZ.data() };
+}
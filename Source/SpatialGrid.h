@@ -0,0 +1,113 @@
+#pragma once
+#include "Math.h"
+#include "FlockArray.h"
+#include "NeighborKernel.h"
+#include <vector>
+#include <cstdint>
+
+// Grade espacial uniforme (hash espacial) para as consultas de vizinhança.
+// As células têm o tamanho do raio de percepção, então todo vizinho de um
+// boid está dentro das 27 células ao redor da célula dele.
+class SpatialGrid {
+public:
+    // Máximo de faixas devolvidas por GatherCandidateRanges (uma por célula vizinha)
+    static constexpr int MaxRanges = 27;
+
+    SpatialGrid(float cellSize);
+
+    // Reconstrói a grade com as posições atuais (uma vez por World::Update).
+    // Também copia posições e velocidades para arrays SoA ordenados por balde,
+    // assim os candidatos de cada balde ficam contíguos para o kernel SIMD.
+    void Build(const FlockArray<Vector3>& positions, const FlockArray<Vector3>& velocities);
+
+    // Só os índices por balde, sem a cópia SoA (para quem usa ForEachCandidate)
+    void Build(const FlockArray<Vector3>& positions);
+
+    // Chama fn(indice) para cada candidato a vizinho de pos.
+    // Os candidatos ainda precisam do teste de distância (colisões de hash).
+    template <typename Fn>
+    void ForEachCandidate(const Vector3& pos, Fn&& fn) const;
+
+    // Preenche ranges com as faixas [begin, end) de GetSortedArrays() que
+    // contêm os candidatos a vizinho de pos. Retorna quantas faixas há.
+    int GatherCandidateRanges(const Vector3& pos, NeighborRange ranges[MaxRanges]) const;
+
+    // Posições e velocidades ordenadas por balde (com folga no final para leituras SIMD)
+    NeighborArrays GetSortedArrays() const;
+
+    float GetCellSize() const { return mCellSize; }
+    void SetCellSize(float cellSize);
+
+private:
+    int CellCoord(float v) const { return static_cast<int>(floorf(v * mInvCellSize)); }
+    uint32_t HashCell(int cx, int cy, int cz) const;
+
+    // Visita cada balde distinto das 27 células ao redor de pos
+    template <typename Fn>
+    void ForEachBucket(const Vector3& pos, Fn&& fn) const;
+
+    float mCellSize;
+    float mInvCellSize;
+    uint32_t mTableMask;
+
+    std::vector<uint32_t> mCellStart; // Início de cada balde em mEntries (tamanho da tabela + 1)
+    std::vector<uint32_t> mEntries;   // Índices dos boids ordenados por balde
+    std::vector<uint32_t> mBoidHash;  // Balde de cada boid (rascunho do Build)
+    std::vector<uint32_t> mCursor;    // Posição de escrita de cada balde (rascunho do Build)
+
+    // Cópia SoA na ordem de mEntries
+    std::vector<float> mSortedX;
+    std::vector<float> mSortedY;
+    std::vector<float> mSortedZ;
+    std::vector<float> mSortedVX;
+    std::vector<float> mSortedVY;
+    std::vector<float> mSortedVZ;
+};
+
+inline uint32_t SpatialGrid::HashCell(int cx, int cy, int cz) const {
+    uint32_t h = (static_cast<uint32_t>(cx) * 73856093u) ^
+                 (static_cast<uint32_t>(cy) * 19349663u) ^
+                 (static_cast<uint32_t>(cz) * 83492791u);
+    return h & mTableMask;
+}
+
+template <typename Fn>
+void SpatialGrid::ForEachBucket(const Vector3& pos, Fn&& fn) const {
+    if (mEntries.empty()) return;
+
+    int cx = CellCoord(pos.x);
+    int cy = CellCoord(pos.y);
+    int cz = CellCoord(pos.z);
+
+    // Células diferentes podem cair no mesmo balde: visita cada balde uma vez só
+    uint32_t visited[27];
+    int visitedCount = 0;
+
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+                uint32_t h = HashCell(cx + dx, cy + dy, cz + dz);
+
+                bool seen = false;
+                for (int k = 0; k < visitedCount; k++) {
+                    if (visited[k] == h) { seen = true; break; }
+                }
+                if (seen) continue;
+                visited[visitedCount++] = h;
+
+                if (mCellStart[h] != mCellStart[h + 1]) {
+                    fn(mCellStart[h], mCellStart[h + 1]);
+                }
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialGrid::ForEachCandidate(const Vector3& pos, Fn&& fn) const {
+    ForEachBucket(pos, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t e = begin; e < end; e++) {
+            fn(mEntries[e]);
+        }
+    });
+}
@@ -0,0 +1,118 @@
+#include "ThreadPool.h"
+#include "Tracer.h"
+
+ThreadPool::ThreadPool()
+    :mStopping(false)
+    ,mJobId(0)
+    ,mActiveWorkers(0)
+    ,mJob(nullptr)
+    ,mJobCount(0)
+    ,mJobGrain(1)
+    ,mJobName(nullptr)
+    ,mNextChunk(0)
+{
+}
+
+ThreadPool::~ThreadPool() {
+    StopWorkers();
+}
+
+void ThreadPool::SetThreadCount(int count) {
+    if (count < 1) count = 1;
+    if (count == GetThreadCount()) return;
+
+    StopWorkers();
+
+    for (int i = 1; i < count; i++) {
+        mWorkers.emplace_back(&ThreadPool::WorkerLoop, this, mJobId);
+    }
+}
+
+void ThreadPool::StopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWakeCond.notify_all();
+
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+    mWorkers.clear();
+
+    mStopping = false;
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& fn,
+                             const char* traceName) {
+    if (count == 0) return;
+    if (grainSize == 0) grainSize = 1;
+
+    // Sem workers (ou trabalho para um bloco só): roda direto na thread atual
+    if (mWorkers.empty() || count <= grainSize) {
+        TraceScope trace(traceName, static_cast<uint32_t>(count));
+        fn(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = &fn;
+        mJobCount = count;
+        mJobGrain = grainSize;
+        mJobName = traceName;
+        mNextChunk.store(0, std::memory_order_relaxed);
+        mActiveWorkers = mWorkers.size();
+        mJobId++;
+    }
+    mWakeCond.notify_all();
+
+    RunChunks();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCond.wait(lock, [this] { return mActiveWorkers == 0; });
+    mJob = nullptr;
+}
+
+void ThreadPool::RunChunks() {
+    const size_t chunkCount = (mJobCount + mJobGrain - 1) / mJobGrain;
+    const bool tracing = Tracer::IsEnabled();
+    const uint64_t traceStart = tracing ? Tracer::Now() : 0;
+    size_t items = 0;
+
+    while (true) {
+        size_t chunk = mNextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= chunkCount) break;
+
+        size_t begin = chunk * mJobGrain;
+        size_t end = begin + mJobGrain;
+        if (end > mJobCount) end = mJobCount;
+        (*mJob)(begin, end);
+        items += end - begin;
+    }
+
+    // Um evento por thread com a parte do job que ela fez
+    if (tracing && items > 0) {
+        Tracer::Record(mJobName, traceStart, Tracer::Now(), static_cast<uint32_t>(items));
+    }
+}
+
+void ThreadPool::WorkerLoop(uint64_t lastJob) {
+    Tracer::SetThreadName("worker");
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeCond.wait(lock, [&] { return mStopping || mJobId != lastJob; });
+            if (mStopping) return;
+            lastJob = mJobId;
+        }
+
+        RunChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (--mActiveWorkers == 0) mDoneCond.notify_one();
+        }
+    }
+}
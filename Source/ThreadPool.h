@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads persistente: as threads são criadas uma vez e reaproveitadas
+// a cada frame, em vez de criar/destruir threads em todo World::Update.
+class ThreadPool {
+public:
+    ThreadPool();
+    ~ThreadPool();
+
+    // Total de threads, contando a que chama ParallelFor (1 = serial, sem threads extras)
+    void SetThreadCount(int count);
+    int GetThreadCount() const { return static_cast<int>(mWorkers.size()) + 1; }
+
+    // Divide [0, count) em blocos de grainSize e executa fn(begin, end) em paralelo.
+    // Os blocos são distribuídos dinamicamente (quem termina pega o próximo),
+    // o que equilibra regiões densas e vazias do bando. Bloqueia até tudo terminar;
+    // a thread que chama também trabalha. Com o Tracer ligado, cada thread grava
+    // um evento traceName cobrindo os blocos que pegou.
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& fn,
+                     const char* traceName = "parallel_for");
+
+private:
+    // lastJob: id do último job já visto (workers novos não pegam jobs antigos)
+    void WorkerLoop(uint64_t lastJob);
+    void RunChunks();
+    void StopWorkers();
+
+    std::vector<std::thread> mWorkers;
+
+    std::mutex mMutex;
+    std::condition_variable mWakeCond; // Avisa os workers que há um job novo
+    std::condition_variable mDoneCond; // Avisa quem chamou que os workers terminaram
+    bool mStopping;
+    uint64_t mJobId;
+    size_t mActiveWorkers; // Workers que ainda não terminaram o job atual
+
+    // Job atual
+    const std::function<void(size_t, size_t)>* mJob;
+    size_t mJobCount;
+    size_t mJobGrain;
+    const char* mJobName;
+    std::atomic<size_t> mNextChunk;
+};
@@ -0,0 +1,138 @@
+#include "Tracer.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint32_t items;
+};
+
+struct ThreadBuffer {
+    const char* threadName;
+    std::vector<TraceEvent> events;
+    size_t dropped;
+};
+
+// Buffers de todas as threads que já gravaram; a posição é o tid no arquivo.
+// Os buffers nunca são liberados, então o ponteiro thread_local continua válido
+// mesmo depois de um Start limpar os eventos.
+std::mutex sRegistryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> sBuffers;
+thread_local ThreadBuffer* tBuffer = nullptr;
+
+std::chrono::steady_clock::time_point sEpoch = std::chrono::steady_clock::now();
+
+ThreadBuffer& GetThreadBuffer() {
+    if (!tBuffer) {
+        std::lock_guard<std::mutex> lock(sRegistryMutex);
+        sBuffers.emplace_back(new ThreadBuffer{ nullptr, {}, 0 });
+        tBuffer = sBuffers.back().get();
+    }
+    return *tBuffer;
+}
+
+// Nomes vêm de literais do código, mas escapa o básico do JSON por garantia
+void WriteJsonString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') fputc('\\', file);
+        fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+}
+
+std::atomic<bool> Tracer::sEnabled(false);
+
+void Tracer::Start() {
+    {
+        std::lock_guard<std::mutex> lock(sRegistryMutex);
+        for (auto& buffer : sBuffers) {
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+    }
+    SetThreadName("main");
+    sEpoch = std::chrono::steady_clock::now();
+    sEnabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::Stop() {
+    sEnabled.store(false, std::memory_order_relaxed);
+}
+
+uint64_t Tracer::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - sEpoch).count());
+}
+
+void Tracer::Record(const char* name, uint64_t startNs, uint64_t endNs, uint32_t items) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    if (buffer.events.size() >= MaxEventsPerThread) {
+        buffer.dropped++;
+        return;
+    }
+    buffer.events.push_back({ name, startNs, endNs > startNs ? endNs - startNs : 0, items });
+}
+
+void Tracer::SetThreadName(const char* name) {
+    GetThreadBuffer().threadName = name;
+}
+
+size_t Tracer::GetEventCount() {
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+    size_t count = 0;
+    for (auto& buffer : sBuffers) {
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+size_t Tracer::GetDroppedCount() {
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+    size_t count = 0;
+    for (auto& buffer : sBuffers) {
+        count += buffer->dropped;
+    }
+    return count;
+}
+
+bool Tracer::WriteJson(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (size_t tid = 0; tid < sBuffers.size(); tid++) {
+        const ThreadBuffer& buffer = *sBuffers[tid];
+
+        // Metadado com o nome da thread
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":", first ? "" : ",\n", tid);
+        WriteJsonString(file, buffer.threadName ? buffer.threadName : "thread");
+        fprintf(file, "}}");
+        first = false;
+
+        // ts e dur em microssegundos
+        for (const TraceEvent& event : buffer.events) {
+            fprintf(file, ",\n{\"name\":");
+            WriteJsonString(file, event.name);
+            fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f",
+                    tid, event.startNs / 1000.0, event.durationNs / 1000.0);
+            if (event.items != NoItems) fprintf(file, ",\"args\":{\"items\":%u}", event.items);
+            fprintf(file, "}");
+        }
+    }
+    fprintf(file, "\n]}\n");
+
+    return fclose(file) == 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Rastreamento opcional em formato Chrome trace-event (chrome://tracing, Perfetto):
+// cada escopo vira um evento com início e duração na thread em que rodou, para
+// ver frames individuais em vez das médias do Profiler.
+//
+// Cada thread grava no próprio buffer, registrado uma vez (com mutex) no primeiro
+// evento; depois disso gravar não usa lock nem atomics além da flag de ligado.
+// Start, Stop e WriteJson são chamados da thread principal fora de ParallelFor,
+// quando nenhuma outra thread está gravando.
+class Tracer {
+public:
+    // Eventos guardados por thread; o que passar disso é descartado e contado
+    static constexpr size_t MaxEventsPerThread = 1 << 20;
+
+    // Nenhum valor em args
+    static constexpr uint32_t NoItems = UINT32_MAX;
+
+    // Limpa os buffers e começa a gravar; a thread que chama aparece como "main"
+    static void Start();
+    static void Stop();
+    static bool IsEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    // Nanossegundos desde o Start
+    static uint64_t Now();
+
+    // name precisa viver até o WriteJson (na prática, literais)
+    static void Record(const char* name, uint64_t startNs, uint64_t endNs, uint32_t items = NoItems);
+
+    // Nome da thread atual no visualizador
+    static void SetThreadName(const char* name);
+
+    static size_t GetEventCount();
+    static size_t GetDroppedCount();
+
+    // {"traceEvents": [...]} com um evento "X" (início + duração) por escopo
+    static bool WriteJson(const char* path);
+
+private:
+    static std::atomic<bool> sEnabled;
+};
+
+// Grava o escopo como um evento se o Tracer estiver ligado
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, uint32_t items = Tracer::NoItems)
+        :mName(name)
+        ,mItems(items)
+        ,mStart(Tracer::IsEnabled() ? Tracer::Now() : 0)
+        ,mActive(Tracer::IsEnabled())
+    {
+    }
+
+    ~TraceScope() {
+        if (mActive && Tracer::IsEnabled()) {
+            Tracer::Record(mName, mStart, Tracer::Now(), mItems);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* mName;
+    uint32_t mItems;
+    uint64_t mStart;
+    bool mActive;
+};
@@ -0,0 +1,136 @@
+#include "TrajectoryWriter.h"
+#include <chrono>
+
+static const char kTrajectoryMagic[8] = { 'B', 'O', 'I', 'D', 'T', 'R', 'A', 'J' };
+static const uint32_t kTrajectoryVersion = 1;
+
+TrajectoryWriter::TrajectoryWriter()
+    :mFile(nullptr)
+    ,mFormat(Format::Binary)
+    ,mHead(0)
+    ,mTail(0)
+    ,mStopping(false)
+    ,mSubmitted(0)
+    ,mWritten(0)
+    ,mDropped(0)
+{
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    Close();
+}
+
+bool TrajectoryWriter::Open(const char* path, Format format, size_t capacity) {
+    Close();
+
+    mFile = fopen(path, format == Format::Csv ? "w" : "wb");
+    if (!mFile) return false;
+
+    mFormat = format;
+    if (mFormat == Format::Csv) {
+        fprintf(mFile, "frame,time,id,px,py,pz,vx,vy,vz\n");
+    }
+    else {
+        fwrite(kTrajectoryMagic, 1, sizeof(kTrajectoryMagic), mFile);
+        fwrite(&kTrajectoryVersion, sizeof(kTrajectoryVersion), 1, mFile);
+    }
+
+    mSlots.clear();
+    mSlots.resize(capacity > 0 ? capacity : 1);
+    mHead.store(0);
+    mTail.store(0);
+    mSubmitted.store(0);
+    mWritten.store(0);
+    mDropped.store(0);
+    mStopping.store(false);
+
+    mThread = std::thread(&TrajectoryWriter::WriterLoop, this);
+    return true;
+}
+
+void TrajectoryWriter::Close() {
+    if (!mFile) return;
+
+    mStopping.store(true);
+    mCond.notify_one();
+    mThread.join();
+
+    fclose(mFile);
+    mFile = nullptr;
+}
+
+bool TrajectoryWriter::Submit(uint64_t frame, double time, const FlockArray<uint32_t>& ids,
+                              const FlockArray<Vector3>& positions, const FlockArray<Vector3>& velocities) {
+    if (!mFile) return false;
+    mSubmitted.fetch_add(1, std::memory_order_relaxed);
+
+    // Cheio: descarta em vez de esperar pela thread de escrita
+    uint64_t head = mHead.load(std::memory_order_relaxed);
+    if (head - mTail.load(std::memory_order_acquire) >= mSlots.size()) {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // O slot é livre: a thread de escrita já terminou com ele (acquire no mTail).
+    // assign reaproveita a memória dos frames anteriores.
+    Slot& slot = mSlots[head % mSlots.size()];
+    slot.frame = frame;
+    slot.time = time;
+    slot.ids.assign(ids.begin(), ids.end());
+    slot.positions.assign(positions.begin(), positions.end());
+    slot.velocities.assign(velocities.begin(), velocities.end());
+
+    mHead.store(head + 1, std::memory_order_release);
+
+    // Sem segurar o mutex (o produtor nunca bloqueia); se o aviso se perder,
+    // a thread de escrita acorda sozinha no timeout do wait_for
+    mCond.notify_one();
+    return true;
+}
+
+void TrajectoryWriter::WriterLoop() {
+    for (;;) {
+        uint64_t tail = mTail.load(std::memory_order_relaxed);
+
+        if (tail == mHead.load(std::memory_order_acquire)) {
+            // Vazio: para só depois de gravar tudo que já estava no buffer
+            if (mStopping.load()) break;
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCond.wait_for(lock, std::chrono::milliseconds(10), [this, tail] {
+                return mStopping.load() || mHead.load(std::memory_order_acquire) != tail;
+            });
+            continue;
+        }
+
+        WriteSlot(mSlots[tail % mSlots.size()]);
+        mWritten.fetch_add(1, std::memory_order_relaxed);
+
+        // Libera o slot para o produtor
+        mTail.store(tail + 1, std::memory_order_release);
+    }
+
+    fflush(mFile);
+}
+
+void TrajectoryWriter::WriteSlot(const Slot& slot) {
+    const uint32_t count = static_cast<uint32_t>(slot.positions.size());
+
+    if (mFormat == Format::Csv) {
+        for (uint32_t i = 0; i < count; i++) {
+            const Vector3& p = slot.positions[i];
+            const Vector3& v = slot.velocities[i];
+            fprintf(mFile, "%llu,%.6f,%u,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g\n",
+                    static_cast<unsigned long long>(slot.frame), slot.time, slot.ids[i],
+                    p.x, p.y, p.z, v.x, v.y, v.z);
+        }
+        return;
+    }
+
+    fwrite(&slot.frame, sizeof(slot.frame), 1, mFile);
+    fwrite(&slot.time, sizeof(slot.time), 1, mFile);
+    fwrite(&count, sizeof(count), 1, mFile);
+    fwrite(slot.ids.data(), sizeof(uint32_t), count, mFile);
+    fwrite(slot.positions.data(), sizeof(Vector3), count, mFile);
+    fwrite(slot.velocities.data(), sizeof(Vector3), count, mFile);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "Math.h"
+#include "FlockArray.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Exportação das trajetórias do bando (posição e velocidade de cada boid por
+// frame) para processamento offline. O World copia o frame para um buffer
+// circular de tamanho fixo e uma thread de fundo grava no disco; o Update
+// nunca espera pelo disco. Se o buffer estiver cheio o frame é descartado
+// e contado em GetDroppedFrames().
+//
+// Formato binário: "BOIDTRAJ", uint32 versão, e por frame
+//   uint64 frame, double tempo, uint32 boids, uint32 ids[boids],
+//   float posições[boids * 3], float velocidades[boids * 3]
+// CSV: frame,time,id,px,py,pz,vx,vy,vz (uma linha por boid)
+class TrajectoryWriter {
+public:
+    enum class Format {
+        Binary,
+        Csv
+    };
+
+    // Frames que cabem no buffer antes de começar a descartar
+    static constexpr size_t DefaultCapacity = 8;
+
+    TrajectoryWriter();
+    ~TrajectoryWriter();
+
+    // Abre o arquivo e inicia a thread de escrita
+    bool Open(const char* path, Format format, size_t capacity = DefaultCapacity);
+
+    // Espera gravar o que está no buffer, para a thread e fecha o arquivo
+    void Close();
+
+    bool IsOpen() const { return mFile != nullptr; }
+
+    // Copia o frame para o buffer sem bloquear. Retorna false (e conta) se estiver cheio.
+    bool Submit(uint64_t frame, double time, const FlockArray<uint32_t>& ids,
+                const FlockArray<Vector3>& positions, const FlockArray<Vector3>& velocities);
+
+    uint64_t GetSubmittedFrames() const { return mSubmitted.load(std::memory_order_relaxed); }
+    uint64_t GetWrittenFrames() const { return mWritten.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedFrames() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        uint64_t frame;
+        double time;
+        std::vector<uint32_t> ids;
+        std::vector<Vector3> positions;
+        std::vector<Vector3> velocities;
+    };
+
+    void WriterLoop();
+    void WriteSlot(const Slot& slot);
+
+    FILE* mFile;
+    Format mFormat;
+
+    // Buffer circular com um produtor (World::Update) e um consumidor (a thread de escrita).
+    // mHead só é escrito pelo produtor e mTail só pelo consumidor.
+    std::vector<Slot> mSlots;
+    std::atomic<uint64_t> mHead;
+    std::atomic<uint64_t> mTail;
+
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCond;
+    std::atomic<bool> mStopping;
+
+    std::atomic<uint64_t> mSubmitted;
+    std::atomic<uint64_t> mWritten;
+    std::atomic<uint64_t> mDropped;
+};
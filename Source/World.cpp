@@ -1,62 +1,293 @@
 #include "World.h"
+#include "Profiler.h"
 #include <algorithm>
-#include <GL/glut.h>
+#include <chrono>
 #include <cmath>
 #include "Random.h"
 
 World::World()
-    :mGoal(nullptr)
+    :mSeed(0)
+    ,mHasSeed(false)
+    ,mObstaclesDirty(false)
+    ,mGoal()
     ,mCameraMode(CameraMode::Behind)
+    ,mGrid(Boid::PerceptionRadius)
+    ,mSortInterval(32)
+    ,mFramesSinceSort(0)
+    ,mLodDistances{ 0.0f, 0.0f, 0.0f }
+    ,mLodFrame(0)
+    ,mFrameIndex(0)
+    ,mSimTime(0.0)
     ,mIsPaused(false)
     ,mIsFogEnabled(false)
     ,mCamEye(0, 50, 50)  // Valores iniciais para não começar no zero
     ,mCamAt(0, 0, 0)
     ,mZoomDist(0.0f)
+    ,mPrevCamEye(0, 50, 50)
+    ,mPrevCamAt(0, 0, 0)
 {
+    ResetLodStats();
 }
 
-void World::Init() {
-    Random::Init();
-
-    // Cria alguns boids iniciais
-    for (int i = 0; i < 30; i++) {
-        new Boid(this);
+void World::Init(int boidCount) {
+    if (mHasSeed) {
+        Random::Seed(mSeed);
+    }
+    else {
+        mSeed = Random::Init();
     }
 
-    mGoal = new Boid(this);
-    mGoal->SetColor(Vector3::UnitZ); // Azul para o objetivo
+    // Cria alguns boids iniciais (+1 para o objetivo)
+    mFlock.Reserve(boidCount + 1);
+    mBoidPool.Reserve(boidCount + 1);
+    SpawnFlock(boidCount, SpawnDistribution::Box(Vector3(-10.0f, 25.0f, -10.0f), Vector3(10.0f, 35.0f, 10.0f)));
+
+    Boid* goal = mBoidPool.Create(this);
+    goal->SetColor(Vector3::UnitZ); // Azul para o objetivo
+    mGoal = mFlock.GetHandle(goal->GetIndex());
 
     // --- CRIAÇÃO DE OBSTÁCULOS ---
     // Cria 3 esferas grandes espalhadas
-    mObstacles.push_back({ Vector3(30.0f, 10.0f, 30.0f), 8.0f });
-    mObstacles.push_back({ Vector3(-30.0f, 15.0f, -40.0f), 12.0f });
-    mObstacles.push_back({ Vector3(-40.0f, 8.0f, 40.0f), 10.0f });
+    AddObstacle({ Vector3(30.0f, 10.0f, 30.0f), 8.0f });
+    AddObstacle({ Vector3(-30.0f, 15.0f, -40.0f), 12.0f });
+    AddObstacle({ Vector3(-40.0f, 8.0f, 40.0f), 10.0f });
+
+    RebuildScenery();
+}
+
+void World::AddObstacle(const Obstacle& obstacle) {
+    mObstacles.push_back(obstacle);
+    mObstaclesDirty = true;
+}
+
+void World::AddRandomObstacles(int count) {
+    for (int i = 0; i < count; i++) {
+        // GetVector sorteia x, y, z nessa ordem (argumentos de construtor não têm ordem garantida)
+        Vector3 position = Random::GetVector(Vector3(-200.0f, 5.0f, -200.0f), Vector3(200.0f, 60.0f, 200.0f));
+        AddObstacle({ position, Random::GetFloatRange(2.0f, 6.0f) });
+    }
+}
+
+void World::RebuildScenery() {
+    mObstacleBVH.Build(mObstacles, Boid::ObstacleMargin);
+    mSceneryField.Bake(mObstacles, mObstacleBVH, mThreadPool);
+    mObstaclesDirty = false;
 }
 
 void World::Update(float deltaTime) {
+    ScopedTimer updateTimer(Profiler::UpdateTotal);
+
     // Se estiver pausado, não atualiza a física (mas permite input de câmera)
     if (mIsPaused) {
         UpdateCamera(deltaTime);
         return;
     }
 
-    for (auto b : mBoids) {
-        b->Update(deltaTime);
+    // Obstáculos novos: refaz a BVH e o campo antes dos boids consultarem
+    if (mObstaclesDirty) {
+        ScopedTimer timer(Profiler::UpdateScenery);
+        RebuildScenery();
+    }
+
+    // De tempos em tempos reordena o bando para manter vizinhos próximos na memória
+    if (mSortInterval > 0 && ++mFramesSinceSort >= mSortInterval) {
+        ScopedTimer timer(Profiler::UpdateSort);
+        SortFlockByMorton();
+        mFramesSinceSort = 0;
+    }
+
+    {
+        ScopedTimer timer(Profiler::UpdateNeighbors);
+        const FlockFrame& frame = mFlock.Current();
+        if (mNeighborList.IsEnabled()) {
+            // Lista de Verlet: só é reconstruída quando algum boid andou mais que skin / 2
+            mNeighborList.Update(frame.positions, frame.velocities, Boid::PerceptionRadius, mThreadPool);
+        }
+        else {
+            // Reconstrói a grade espacial com as posições do início do frame
+            mGrid.Build(frame.positions, frame.velocities);
+        }
+    }
+
+    std::chrono::steady_clock::time_point updateStart = std::chrono::steady_clock::now();
+
+    if (IsLodEnabled()) {
+        TraceScope trace(Profiler::GetPhaseName(Profiler::UpdateBoids));
+        UpdateBoidsWithLod(deltaTime);
+    }
+    else {
+        TraceScope trace(Profiler::GetPhaseName(Profiler::UpdateBoids));
+        // Cada boid lê só Current() e escreve só o próprio slot em Next(),
+        // então os blocos podem rodar em qualquer ordem e em qualquer thread
+        mThreadPool.ParallelFor(mFlock.Size(), 256, [this, deltaTime](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                Boid::UpdateSlot(*this, i, deltaTime);
+            }
+        }, "flock.partition");
+        mLodStats.bandCounts[0] += mFlock.Size();
+        mLodStats.updated += mFlock.Size();
+    }
+
+    double updateSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - updateStart).count();
+    mLodStats.updateSeconds += updateSeconds;
+    if (Profiler::IsEnabled()) Profiler::Record(Profiler::UpdateBoids, updateSeconds * 1000.0);
+
+    mFlock.SwapBuffers();
+    mFrameIndex++;
+    mSimTime += deltaTime;
+
+    if (mTrajectory.IsOpen()) {
+        ScopedTimer timer(Profiler::UpdateExport);
+        const FlockFrame& current = mFlock.Current();
+        mTrajectory.Submit(mFrameIndex, mSimTime, mFlock.ids, current.positions, current.velocities);
     }
 
     UpdateCamera(deltaTime);
 }
 
+void World::SetLodDistances(float half, float quarter, float eighth) {
+    mLodDistances[0] = half;
+    mLodDistances[1] = quarter;
+    mLodDistances[2] = eighth;
+}
+
+void World::ResetLodStats() {
+    for (int b = 0; b < LodBandCount; b++) {
+        mLodStats.bandCounts[b] = 0;
+    }
+    mLodStats.updated = 0;
+    mLodStats.skipped = 0;
+    mLodStats.updateSeconds = 0.0;
+}
+
+void World::UpdateBoidsWithLod(float deltaTime) {
+    float limitsSq[LodBandCount - 1];
+    for (int b = 0; b < LodBandCount - 1; b++) {
+        limitsSq[b] = mLodDistances[b] * mLodDistances[b];
+    }
+
+    for (std::atomic<uint64_t>& counter : mLodCounters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    const uint32_t lodFrame = mLodFrame++;
+    const size_t goalSlot = GetGoalSlot();
+
+    mThreadPool.ParallelFor(mFlock.Size(), 256, [&](size_t begin, size_t end) {
+        FlockFrame& next = mFlock.Next();
+        const FlockFrame& current = mFlock.Current();
+        uint64_t counts[LodBandCount + 1] = {};
+
+        // Distâncias à câmera do bloco inteiro de uma vez (em lote, SIMD)
+        thread_local std::vector<float> camDistSq;
+        camDistSq.resize(end - begin);
+        Vector3::DistanceSqArray(mCamEye, current.positions.data() + begin, camDistSq.data(), end - begin);
+
+        for (size_t i = begin; i < end; i++) {
+            // Faixa pela distância à câmera; o objetivo é sempre atualizado
+            int band = 0;
+            if (i != goalSlot) {
+                float distSq = camDistSq[i - begin];
+                while (band < LodBandCount - 1 && distSq >= limitsSq[band]) band++;
+            }
+            counts[band]++;
+
+            // Faixa b roda em 1 de cada 2^b frames; o id espalha os boids da faixa entre os frames
+            // (o slot não serve: a reordenação de Morton troca os boids de slot)
+            uint32_t mask = (1u << band) - 1;
+            float elapsed = mFlock.lodElapsed[i] + deltaTime;
+            if (((lodFrame + mFlock.ids[i]) & mask) == 0) {
+                Boid::UpdateSlot(*this, i, elapsed);
+                mFlock.lodElapsed[i] = 0.0f;
+            }
+            else {
+                // Pulado: o estado segue igual no próximo frame
+                next.CopySlot(current, i);
+                mFlock.lodElapsed[i] = elapsed;
+                counts[LodBandCount]++;
+            }
+        }
+
+        for (int b = 0; b <= LodBandCount; b++) {
+            mLodCounters[b].fetch_add(counts[b], std::memory_order_relaxed);
+        }
+    }, "flock.partition");
+
+    uint64_t skipped = mLodCounters[LodBandCount].load(std::memory_order_relaxed);
+    for (int b = 0; b < LodBandCount; b++) {
+        mLodStats.bandCounts[b] += mLodCounters[b].load(std::memory_order_relaxed);
+    }
+    mLodStats.skipped += skipped;
+    mLodStats.updated += mFlock.Size() - skipped;
+}
+
+// Espalha os 10 bits menos significativos de v, deixando dois zeros entre cada bit
+static uint32_t ExpandBits(uint32_t v) {
+    v &= 0x3FF;
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v << 8)) & 0x0300F00F;
+    v = (v | (v << 4)) & 0x030C30C3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+void World::SortFlockByMorton() {
+    const size_t count = mFlock.Size();
+    if (count < 2) return;
+
+    const FlockArray<Vector3>& positions = mFlock.Current().positions;
+
+    // Quantiza as posições em 10 bits por eixo dentro da caixa que envolve o bando
+    Vector3 minPos = positions[0];
+    Vector3 maxPos = positions[0];
+    for (const Vector3& p : positions) {
+        minPos = Vector3(Math::Min(minPos.x, p.x), Math::Min(minPos.y, p.y), Math::Min(minPos.z, p.z));
+        maxPos = Vector3(Math::Max(maxPos.x, p.x), Math::Max(maxPos.y, p.y), Math::Max(maxPos.z, p.z));
+    }
+    Vector3 extent = maxPos - minPos;
+    float scale = 1023.0f / Math::Max(Math::Max(extent.x, extent.y), Math::Max(extent.z, 0.001f));
+
+    mSortKeys.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        Vector3 q = (positions[i] - minPos) * scale;
+        uint32_t code = (ExpandBits(static_cast<uint32_t>(q.x)) << 2) |
+                        (ExpandBits(static_cast<uint32_t>(q.y)) << 1) |
+                        ExpandBits(static_cast<uint32_t>(q.z));
+        mSortKeys[i] = (static_cast<uint64_t>(code) << 32) | static_cast<uint64_t>(i);
+    }
+
+    std::sort(mSortKeys.begin(), mSortKeys.end());
+
+    mSortOrder.resize(count);
+    bool changed = false;
+    for (size_t i = 0; i < count; i++) {
+        mSortOrder[i] = static_cast<uint32_t>(mSortKeys[i] & 0xFFFFFFFFu);
+        changed |= (mSortOrder[i] != i);
+    }
+
+    // Os Boids e os handles (inclusive mGoal) continuam válidos; só os índices dos slots mudam
+    if (changed) {
+        mFlock.Permute(mSortOrder);
+        mNeighborList.Invalidate();
+    }
+}
+
 void World::UpdateCamera(float dt) {
+    ScopedTimer timer(Profiler::UpdateCamera);
+
+    mPrevCamEye = mCamEye;
+    mPrevCamAt = mCamAt;
+
     Vector3 center(0, 0, 0);
     Vector3 avgVel(0, 0, 1); // Valor padrão seguro
 
-    if (!mBoids.empty()) {
-        for (auto b : mBoids) {
-            center += b->GetPosition();
-            avgVel += b->GetVelocity();
+    if (mFlock.Size() > 0) {
+        const FlockFrame& frame = mFlock.Current();
+        for (size_t i = 0; i < mFlock.Size(); i++) {
+            center += frame.positions[i];
+            avgVel += frame.velocities[i];
         }
-        center *= 1.0f / static_cast<float>(mBoids.size());
+        center *= 1.0f / static_cast<float>(mFlock.Size());
         avgVel.Normalize(); // Direção média do bando
     }
     if (std::isnan(center.x)) center = Vector3::Zero;
@@ -100,124 +331,9 @@ void World::UpdateCamera(float dt) {
     mCamAt = Vector3::Lerp(mCamAt, targetAt, smoothFactor);
 }
 
-void World::Draw() {
-    SetCamera();
-
-    // --- CONFIGURAÇÃO DE FOG (NEBLINA) ---
-    if (mIsFogEnabled) {
-        glEnable(GL_FOG);
-        GLfloat fogColor[] = { 0.5f, 0.7f, 1.0f, 1.0f }; // Cor do fundo
-        glFogfv(GL_FOG_COLOR, fogColor);
-        glFogi(GL_FOG_MODE, GL_EXP2); // Decaimento exponencial
-        glFogf(GL_FOG_DENSITY, 0.015f);
-        glHint(GL_FOG_HINT, GL_NICEST);
-    } else {
-        glDisable(GL_FOG);
-    }
-
-    GLfloat light_pos[] = { 10.0f, 100.0f, 50.0f, 1.0f };
-    glLightfv(GL_LIGHT0, GL_POSITION, light_pos);
-
-    DrawGround();
-    DrawTower();
-    DrawObstacles();
-
-    // Desenha os Boids Reais
-    for (auto b : mBoids) {
-        b->Draw();
-    }
-
-    // Desenha as Sombras (Projeção Paralela no chão)
-    DrawShadows();
-}
-
-void World::DrawGround() {
-    glColor3f(0.3f, 0.6f, 0.3f);
-    glBegin(GL_QUADS);
-    glNormal3f(0, 1, 0);
-    glVertex3f(-500, 0, -500);
-    glVertex3f(-500, 0, 500);
-    glVertex3f(500, 0, 500);
-    glVertex3f(500, 0, -500);
-    glEnd();
-}
-
-void World::DrawTower() {
-    glPushMatrix();
-    glTranslatef(0, 0, 0);
-    glRotatef(-90.0f, 1.0f, 0.0f, 0.0f);
-    glColor3f(0.6f, 0.4f, 0.2f);
-    glutSolidCone(3, 20, 20, 20); // Torre um pouco mais alta
-    glPopMatrix();
-}
-
-void World::DrawObstacles() {
-    glColor3f(0.8f, 0.2f, 0.2f); // Obstáculos vermelhos
-    for (const auto& obs : mObstacles) {
-        glPushMatrix();
-        glTranslatef(obs.position.x, obs.position.y, obs.position.z);
-        glutSolidSphere(obs.radius, 20, 20);
-        glPopMatrix();
-    }
-}
-
-void World::DrawShadows() {
-    // Desabilita iluminação e profundidade para desenhar sombras "chapadas"
-    glDisable(GL_LIGHTING);
-
-    // MANTÉM DEPTH TEST LIGADO
-    // Isso garante que se houver uma esfera na frente da sombra, a esfera vence.
-    glEnable(GL_DEPTH_TEST);
-
-    // HABILITA TRANSPARÊNCIA (Blending)
-    // Isso faz a sombra ficar suave e escura, em vez de um bloco preto sólido
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glDepthMask(GL_FALSE);
-    
-    glPushMatrix();
-    
-    // Matriz de projeção de sombra simples (achata Y em 0)
-    // Sobe um pouquinho (0.1) para evitar Z-Fighting com o chão
-    glTranslatef(0.0f, 0.1f, 0.0f);
-    glScalef(1.0f, 0.0f, 1.0f); 
-
-    // Cor preta com 50% de transparência (Alpha = 0.5)
-    glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
-
-    for (auto b : mBoids) {
-        // Desenha apenas a geometria do boid, sem alterar a cor (pois definimos cinza acima)
-        // Nota: O método Draw do boid define cor internamente, o ideal seria ter um DrawGeometry
-        // mas para simplificar, vamos assumir que a cor definida aqui prevalece se desativarmos LIGHTING
-        // ou podemos desenhar manualmente algo simples.
-        
-        // Hack: Vamos chamar o Draw do boid. Como Lighting está OFF, a cor definida 
-        // no glColor3f acima vai "tingir" o objeto se ele não usar texturas.
-        b->Draw(true);
-    }
-
-    glPopMatrix();
-
-    // Restaura estados
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
-    glEnable(GL_LIGHTING);
-}
-
-void World::SetCamera() {
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-
-    // Agora usamos as variáveis interpoladas (suaves)
-    gluLookAt(mCamEye.x, mCamEye.y, mCamEye.z,
-        mCamAt.x, mCamAt.y, mCamAt.z,
-        0, 1, 0);
-}
-
 void World::HandleKey(std::map<unsigned char, bool> keyStates, std::map<unsigned char, bool> prevKeyStates) {
     if (keyStates['+'] && !prevKeyStates['+']) {
-        new Boid(this);
+        mBoidPool.Create(this);
     }
     if (keyStates['-'] && !prevKeyStates['-']) {
         RemoveBoid();
@@ -232,6 +348,9 @@ void World::HandleKey(std::map<unsigned char, bool> keyStates, std::map<unsigned
     }
     if (keyStates['p'] && !prevKeyStates['p']) {
         mIsPaused = !mIsPaused;
+
+        // Congela a interpolação do desenho no estado atual
+        mFlock.Next() = mFlock.Current();
     }
 
     // --- CONTROLE DE ZOOM ---
@@ -246,30 +365,126 @@ void World::HandleKey(std::map<unsigned char, bool> keyStates, std::map<unsigned
     }
 
     // Controle do boid-objetivo (apenas se não estiver pausado ou se quiser permitir mover na pausa)
-    if (mGoal && !mIsPaused) {
-        mGoal->HandleKey(keyStates, prevKeyStates);
+    Boid* goal = GetGoal();
+    if (goal && !mIsPaused) {
+        goal->HandleKey(keyStates, prevKeyStates);
     }
 }
 
-void World::AddBoid(Boid *boid) {
-    mBoids.emplace_back(boid);
+Boid* World::GetBoid(BoidHandle handle) {
+    if (!mFlock.IsValid(handle)) return nullptr;
+
+    size_t index = mFlock.Resolve(handle);
+    if (!mFlock.boids[index]) {
+        mBoidPool.Create(this, index);
+    }
+    return mFlock.boids[index];
 }
 
-void World::RemoveBoid() {
-    if (mBoids.empty()) return;
-    if (mBoids.size() == 1 && mBoids.back() == mGoal) return;
+size_t World::AddBoid(Boid *boid) {
+    mNeighborList.Invalidate();
+    return mFlock.Add(boid);
+}
 
-    if (mBoids.back() != mGoal) {
-        delete mBoids.back();
-        mBoids.pop_back();
-        return;
+size_t World::GrowFlock(size_t count) {
+    size_t first = mFlock.Size();
+    size_t total = first + count;
+
+    // Uma alocação por array, em vez do crescimento geométrico do push_back
+    mFlock.Reserve(total);
+    mBoidPool.Reserve(mBoidPool.GetLiveCount() + count);
+    mFlock.Resize(total);
+
+    for (size_t i = first; i < total; i++) {
+        mFlock.ids[i] = mFlock.nextId++;
+        mBoidPool.Create(this, i);
     }
 
-    for (auto it = mBoids.rbegin(); it != mBoids.rend(); ++it) {
-        if (*it != mGoal) {
-            delete *it;
-            mBoids.erase(std::next(it).base());
-            return;
+    mNeighborList.Invalidate();
+    return first;
+}
+
+// Slots por stream do Random no SpawnFlock (e grão do ParallelFor, para cada
+// bloco cair inteiro numa thread)
+static const size_t kSpawnBlock = 4096;
+
+// Streams do spawn ficam acima dos índices que o Random dá às threads
+static const uint64_t kSpawnStreamBase = uint64_t(1) << 32;
+
+size_t World::SpawnFlock(size_t count, const SpawnDistribution& distribution) {
+    if (distribution.shape == SpawnDistribution::Shape::SnapshotRegion) {
+        return SpawnFromSnapshot(count, distribution);
+    }
+    if (count == 0) return 0;
+
+    size_t first = GrowFlock(count);
+
+    // Mesma inicialização do construtor Boid(World*), com a forma escolhida
+    const float speed = GetGoalSlot() != NoSlot ? 20.0f * 0.8f : 0.0f;
+    mThreadPool.ParallelFor(count, kSpawnBlock, [&](size_t begin, size_t end) {
+        FlockFrame& frame = mFlock.Current();
+        FlockFrame& next = mFlock.Next();
+
+        for (size_t block = begin; block < end; block += kSpawnBlock) {
+            size_t blockEnd = Math::Min(block + kSpawnBlock, end);
+
+            // O stream é do bloco (pelo id do primeiro boid), não da thread
+            RandomStream stream = Random::MakeStream(kSpawnStreamBase + mFlock.ids[first + block]);
+            for (size_t i = first + block; i < first + blockEnd; i++) {
+                if (distribution.shape == SpawnDistribution::Shape::Box) {
+                    frame.positions[i] = stream.GetVector(distribution.min, distribution.max);
+                }
+                else {
+                    // Rejeição no cubo [-1, 1]: uniforme na bola
+                    Vector3 point;
+                    do {
+                        point = stream.GetVector(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+                    } while (point.LengthSq() > 1.0f);
+                    frame.positions[i] = distribution.center + point * distribution.radius;
+                }
+
+                frame.yaws[i] = stream.GetFloatRange(0.0f, 360.0f);
+                frame.prevYaws[i] = frame.yaws[i];
+                frame.pitches[i] = stream.GetFloatRange(-20.0f, 20.0f);
+                frame.speeds[i] = speed;
+                frame.animPhases[i] = stream.GetFloatRange(0.0f, Math::TwoPi);
+                mFlock.maxSpeeds[i] = 20.0f;
+                mFlock.flapSpeeds[i] = stream.GetFloatRange(12.0f, 20.0f);
+                mFlock.colors[i] = Vector3(0.9f, 0.9f, 0.3f);
+
+                next.CopySlot(frame, i);
+            }
         }
+    }, "flock.spawn");
+
+    return count;
+}
+
+void World::RemoveBoid() {
+    if (mFlock.Size() == 0) return;
+    if (mFlock.Size() == 1 && mFlock.GetHandle(0) == mGoal) return;
+
+    // Remove o último boid que não seja o objetivo
+    size_t index = mFlock.Size() - 1;
+    if (mFlock.GetHandle(index) == mGoal) index--;
+
+    RemoveBoid(mFlock.GetHandle(index));
+}
+
+void World::RemoveBoid(BoidHandle handle) {
+    if (!mFlock.IsValid(handle)) return;
+
+    size_t index = mFlock.Resolve(handle);
+    Boid* boid = mFlock.boids[index];
+    mFlock.RemoveSwap(index);
+    mNeighborList.Invalidate();
+    if (boid) mBoidPool.Destroy(boid);
+}
+
+void World::RemoveBoids(const std::vector<BoidHandle>& handles) {
+    // Cada remoção resolve o handle de novo, então as trocas das anteriores
+    // não atrapalham as seguintes
+    for (const BoidHandle& handle : handles) {
+        RemoveBoid(handle);
     }
 }
\ No newline at end of file
@@ -1,28 +1,174 @@
 #pragma once
 #include "Boid.h"
+#include "BoidPool.h"
+#include "FlockState.h"
+#include "SpatialGrid.h"
+#include "NeighborList.h"
+#include "ObstacleBVH.h"
+#include "SceneryField.h"
+#include "TrajectoryWriter.h"
+#include "ThreadPool.h"
 #include <vector>
 #include <map>
+#include <atomic>
 
-// Definição de obstáculo
-struct Obstacle {
-    Vector3 position;
-    float radius;
+// De onde o World::SpawnFlock tira os boids novos
+struct SpawnDistribution {
+    enum class Shape {
+        Box,           // Uniforme na caixa [min, max]
+        Sphere,        // Uniforme na bola (center, radius)
+        SnapshotRegion // Cópia dos boids de um snapshot que estão na caixa [min, max]
+    };
+
+    Shape shape = Shape::Box;
+    Vector3 min;
+    Vector3 max;
+    Vector3 center;
+    float radius = 0.0f;
+
+    // Só para SnapshotRegion: arquivo de origem e deslocamento somado às posições copiadas
+    const char* snapshotPath = nullptr;
+    Vector3 offset;
+
+    static SpawnDistribution Box(const Vector3& min, const Vector3& max) {
+        SpawnDistribution distribution;
+        distribution.shape = Shape::Box;
+        distribution.min = min;
+        distribution.max = max;
+        return distribution;
+    }
+
+    static SpawnDistribution Sphere(const Vector3& center, float radius) {
+        SpawnDistribution distribution;
+        distribution.shape = Shape::Sphere;
+        distribution.center = center;
+        distribution.radius = radius;
+        return distribution;
+    }
+
+    static SpawnDistribution SnapshotRegion(const char* path, const Vector3& min, const Vector3& max,
+                                            const Vector3& offset = Vector3::Zero) {
+        SpawnDistribution distribution;
+        distribution.shape = Shape::SnapshotRegion;
+        distribution.snapshotPath = path;
+        distribution.min = min;
+        distribution.max = max;
+        distribution.offset = offset;
+        return distribution;
+    }
 };
 
 class World {
 public:
     World();
 
-    void Init();
+    void Init(int boidCount = 30);
+
+    // Snapshot binário do mundo (bando, objetivo, obstáculos, câmera) para
+    // retomar sem aquecer a simulação. Load substitui o Init. Retornam false
+    // se o arquivo não puder ser lido/gravado ou não for um snapshot desta versão.
+    // O estado do Random da thread que chama também vai no snapshot: os sorteios
+    // depois do Load continuam a sequência em vez de repetir os já feitos.
+    bool SaveSnapshot(const char* path) const;
+    bool LoadSnapshot(const char* path);
+
+    // Semente do Random usada no Init. Sem SetSeed, vem do std::random_device
+    // (GetSeed devolve a sorteada depois do Init, para a gravação).
+    void SetSeed(uint32_t seed) { mSeed = seed; mHasSeed = true; }
+    uint32_t GetSeed() const { return mSeed; }
     void Update(float dt);
-    void Draw();
+    // alpha: fração do passo atual já decorrida (0 = estado anterior, 1 = atual)
+    void Draw(float alpha = 1.0f);
     void HandleKey(std::map<unsigned char, bool> keyStates, std::map<unsigned char, bool> prevKeyStates);
-    void AddBoid(Boid* boid);
+    size_t AddBoid(Boid* boid);
+
+    // Cria count boids de uma vez, escrevendo direto nos arrays do bando (em
+    // paralelo, com a capacidade reservada antes). Os sorteios usam um stream
+    // do Random por bloco de slots, então o resultado não depende das threads.
+    // Com SnapshotRegion, count limita a cópia (0 = todos os boids da região).
+    // Retorna quantos boids foram criados (0 se o snapshot não puder ser lido).
+    size_t SpawnFlock(size_t count, const SpawnDistribution& distribution);
+
+    // Remove o último boid que não seja o objetivo (tecla '-')
     void RemoveBoid();
 
-    Boid* GetGoal() { return mGoal; }
-    std::vector<Boid*> GetBoids() { return mBoids; }
-    std::vector<Obstacle>& GetObstacles() { return mObstacles; } 
+    // Remoção por handle: O(1) cada, trocando o slot com o último. Handles
+    // inválidos (já removidos) são ignorados.
+    void RemoveBoid(BoidHandle handle);
+    void RemoveBoids(const std::vector<BoidHandle>& handles);
+
+    bool IsValid(BoidHandle handle) const { return mFlock.IsValid(handle); }
+
+    // Boid do handle (nullptr se inválido). Slots carregados de snapshot
+    // ganham o objeto Boid aqui, na primeira vez que alguém pede.
+    Boid* GetBoid(BoidHandle handle);
+
+    // nullptr se não houver objetivo (ou se ele tiver sido removido)
+    Boid* GetGoal() { return GetBoid(mGoal); }
+    BoidHandle GetGoalHandle() const { return mGoal; }
+
+    // Slot atual do objetivo, ou NoSlot se não houver objetivo
+    static constexpr size_t NoSlot = ~size_t(0);
+    size_t GetGoalSlot() const { return mFlock.IsValid(mGoal) ? mFlock.Resolve(mGoal) : NoSlot; }
+    FlockState& GetFlock() { return mFlock; }
+    const FlockState& GetFlock() const { return mFlock; }
+    const SpatialGrid& GetGrid() const { return mGrid; }
+    const NeighborList& GetNeighborList() const { return mNeighborList; }
+    const std::vector<Obstacle>& GetObstacles() const { return mObstacles; }
+    const ObstacleBVH& GetObstacleBVH() const { return mObstacleBVH; }
+    const SceneryField& GetSceneryField() const { return mSceneryField; }
+
+    // A BVH e o campo do cenário são refeitos no próximo Update
+    void AddObstacle(const Obstacle& obstacle);
+
+    // Espalha count esferas aleatórias pela cena (usa o Random: chamar depois do Init)
+    void AddRandomObstacles(int count);
+
+    // Threads usadas no Update (1 = serial)
+    void SetThreadCount(int count) { mThreadPool.SetThreadCount(count); }
+    int GetThreadCount() const { return mThreadPool.GetThreadCount(); }
+
+    // A cada N frames reordena o bando pela curva de Morton (Z-order) das
+    // posições, para vizinhos no espaço ficarem perto na memória (0 = desliga)
+    void SetSortInterval(int frames) { mSortInterval = frames; }
+    int GetSortInterval() const { return mSortInterval; }
+
+    // Lista de vizinhos de Verlet com a margem skin em torno do raio de
+    // percepção (0 = desligada; os vizinhos vêm da grade todo frame). As listas
+    // são faixas de slots, então dependem da reordenação de Morton: sem ela
+    // (SetSortInterval(0)) ficam fragmentadas e mais lentas que a grade.
+    void SetNeighborListSkin(float skin) { mNeighborList.SetSkin(skin); }
+
+    // LOD temporal por distância à câmera (mCamEye): além de cada distância o
+    // boid é atualizado a 1/2, 1/4 e 1/8 dos frames, com o dt acumulado.
+    // Os boids de uma faixa se revezam pelo id estável
+    // (não pelo slot, que muda na reordenação). Distâncias em ordem crescente; 0 desliga.
+    static constexpr int LodBandCount = 4;
+    void SetLodDistances(float half, float quarter, float eighth);
+    bool IsLodEnabled() const { return mLodDistances[0] > 0.0f; }
+    float GetLodDistance(int index) const { return mLodDistances[index]; }
+
+    // Estatísticas do LOD desde o último ResetLodStats
+    struct LodStats {
+        uint64_t bandCounts[LodBandCount]; // Boids-frame em cada faixa (cheia, 1/2, 1/4, 1/8)
+        uint64_t updated;                  // Updates de boid executados
+        uint64_t skipped;                  // Updates de boid pulados pelo LOD
+        double updateSeconds;              // Tempo total da fase de Update dos boids
+    };
+    const LodStats& GetLodStats() const { return mLodStats; }
+    void ResetLodStats();
+
+    // Exporta posição e velocidade de todos os boids a cada passo (em segundo plano;
+    // frames são descartados se o disco não acompanhar, nunca bloqueia o Update)
+    bool OpenTrajectory(const char* path, TrajectoryWriter::Format format) { return mTrajectory.Open(path, format); }
+    void CloseTrajectory() { mTrajectory.Close(); }
+    const TrajectoryWriter& GetTrajectory() const { return mTrajectory; }
+
+    // Passos simulados e tempo simulado desde o Init
+    uint64_t GetFrameIndex() const { return mFrameIndex; }
+    double GetSimTime() const { return mSimTime; }
+
+    void UpdateCamera(float dt); // Nova função para calcular física da câmera
 
 private:
     enum class CameraMode {
@@ -31,11 +177,54 @@ private:
         Side
     };
     
-    std::vector<Boid*> mBoids;
+    uint32_t mSeed;
+    bool mHasSeed;
+
+    FlockState mFlock;
+    BoidPool mBoidPool; // Memória dos Boids do mFlock
     std::vector<Obstacle> mObstacles; 
-    Boid* mGoal;
+    ObstacleBVH mObstacleBVH;
+    SceneryField mSceneryField; // Desvio do cenário estático pré-calculado
+    bool mObstaclesDirty;
+
+    void RebuildScenery();
+
+    // Abre count slots novos no fim do bando (ids e Boids já criados); retorna o primeiro
+    size_t GrowFlock(size_t count);
+    size_t SpawnFromSnapshot(size_t count, const SpawnDistribution& distribution);
+
+    BoidHandle mGoal;
     CameraMode mCameraMode;
 
+    // Grade de vizinhança, reconstruída uma vez por frame
+    SpatialGrid mGrid;
+
+    // Alternativa à grade: lista de vizinhos reaproveitada entre frames
+    NeighborList mNeighborList;
+
+    // Atualização paralela
+    ThreadPool mThreadPool;
+
+    // Reordenação pela curva de Morton
+    int mSortInterval;
+    int mFramesSinceSort;
+    std::vector<uint64_t> mSortKeys; // (código de Morton << 32) | slot
+    std::vector<uint32_t> mSortOrder;
+
+    void SortFlockByMorton();
+
+    // LOD temporal
+    float mLodDistances[LodBandCount - 1];
+    uint32_t mLodFrame;
+    LodStats mLodStats;
+    std::atomic<uint64_t> mLodCounters[LodBandCount + 1]; // Faixas + pulados (somados pelas threads)
+
+    void UpdateBoidsWithLod(float deltaTime);
+
+    uint64_t mFrameIndex;
+    double mSimTime;
+    TrajectoryWriter mTrajectory;
+
     // Estados Globais
     bool mIsPaused;
     bool mIsFogEnabled;
@@ -44,11 +233,12 @@ private:
     Vector3 mCamAt;     // Para onde ela está olhando agora
     float mZoomDist;
 
-    void UpdateCamera(float dt); // Nova função para calcular física da câmera
+    Vector3 mPrevCamEye; // Câmera no passo anterior (para interpolar o desenho)
+    Vector3 mPrevCamAt;
 
-    void SetCamera();
+    void SetCamera(float alpha);
     void DrawGround();
     void DrawTower();
     void DrawObstacles();
-    void DrawShadows(); 
+    void DrawShadows(float alpha);
 };
\ No newline at end of file
@@ -0,0 +1,137 @@
+// Desenho do mundo em OpenGL/GLUT (fica fora do núcleo da simulação)
+
+#include "World.h"
+#include "Profiler.h"
+#include <GL/glut.h>
+
+void World::Draw(float alpha) {
+    ScopedTimer drawTimer(Profiler::DrawTotal);
+
+    SetCamera(alpha);
+
+    // --- CONFIGURAÇÃO DE FOG (NEBLINA) ---
+    if (mIsFogEnabled) {
+        glEnable(GL_FOG);
+        GLfloat fogColor[] = { 0.5f, 0.7f, 1.0f, 1.0f }; // Cor do fundo
+        glFogfv(GL_FOG_COLOR, fogColor);
+        glFogi(GL_FOG_MODE, GL_EXP2); // Decaimento exponencial
+        glFogf(GL_FOG_DENSITY, 0.015f);
+        glHint(GL_FOG_HINT, GL_NICEST);
+    } else {
+        glDisable(GL_FOG);
+    }
+
+    GLfloat light_pos[] = { 10.0f, 100.0f, 50.0f, 1.0f };
+    glLightfv(GL_LIGHT0, GL_POSITION, light_pos);
+
+    {
+        ScopedTimer timer(Profiler::DrawScenery);
+        DrawGround();
+        DrawTower();
+        DrawObstacles();
+    }
+
+    // Desenha os Boids Reais
+    {
+        ScopedTimer timer(Profiler::DrawBoids);
+        for (size_t i = 0; i < mFlock.Size(); i++) {
+            Boid::DrawSlot(*this, i, alpha);
+        }
+    }
+
+    // Desenha as Sombras (Projeção Paralela no chão)
+    {
+        ScopedTimer timer(Profiler::DrawShadows);
+        DrawShadows(alpha);
+    }
+}
+
+void World::DrawGround() {
+    TraceScope trace("draw.ground");
+    glColor3f(0.3f, 0.6f, 0.3f);
+    glBegin(GL_QUADS);
+    glNormal3f(0, 1, 0);
+    glVertex3f(-500, 0, -500);
+    glVertex3f(-500, 0, 500);
+    glVertex3f(500, 0, 500);
+    glVertex3f(500, 0, -500);
+    glEnd();
+}
+
+void World::DrawTower() {
+    TraceScope trace("draw.tower");
+    glPushMatrix();
+    glTranslatef(0, 0, 0);
+    glRotatef(-90.0f, 1.0f, 0.0f, 0.0f);
+    glColor3f(0.6f, 0.4f, 0.2f);
+    glutSolidCone(3, 20, 20, 20); // Torre um pouco mais alta
+    glPopMatrix();
+}
+
+void World::DrawObstacles() {
+    TraceScope trace("draw.obstacles", static_cast<uint32_t>(mObstacles.size()));
+    glColor3f(0.8f, 0.2f, 0.2f); // Obstáculos vermelhos
+    for (const auto& obs : mObstacles) {
+        glPushMatrix();
+        glTranslatef(obs.position.x, obs.position.y, obs.position.z);
+        glutSolidSphere(obs.radius, 20, 20);
+        glPopMatrix();
+    }
+}
+
+void World::DrawShadows(float alpha) {
+    // Desabilita iluminação e profundidade para desenhar sombras "chapadas"
+    glDisable(GL_LIGHTING);
+
+    // MANTÉM DEPTH TEST LIGADO
+    // Isso garante que se houver uma esfera na frente da sombra, a esfera vence.
+    glEnable(GL_DEPTH_TEST);
+
+    // HABILITA TRANSPARÊNCIA (Blending)
+    // Isso faz a sombra ficar suave e escura, em vez de um bloco preto sólido
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glDepthMask(GL_FALSE);
+    
+    glPushMatrix();
+    
+    // Matriz de projeção de sombra simples (achata Y em 0)
+    // Sobe um pouquinho (0.1) para evitar Z-Fighting com o chão
+    glTranslatef(0.0f, 0.1f, 0.0f);
+    glScalef(1.0f, 0.0f, 1.0f); 
+
+    // Cor preta com 50% de transparência (Alpha = 0.5)
+    glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
+
+    for (size_t i = 0; i < mFlock.Size(); i++) {
+        // Desenha apenas a geometria do boid, sem alterar a cor (pois definimos cinza acima)
+        // Nota: O método Draw do boid define cor internamente, o ideal seria ter um DrawGeometry
+        // mas para simplificar, vamos assumir que a cor definida aqui prevalece se desativarmos LIGHTING
+        // ou podemos desenhar manualmente algo simples.
+        
+        // Hack: Vamos chamar o Draw do boid. Como Lighting está OFF, a cor definida 
+        // no glColor3f acima vai "tingir" o objeto se ele não usar texturas.
+        Boid::DrawSlot(*this, i, alpha, true);
+    }
+
+    glPopMatrix();
+
+    // Restaura estados
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    glEnable(GL_LIGHTING);
+}
+
+void World::SetCamera(float alpha) {
+    TraceScope trace("draw.camera");
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    // Agora usamos as variáveis interpoladas (suaves), entre o passo anterior e o atual
+    Vector3 eye = Vector3::Lerp(mPrevCamEye, mCamEye, alpha);
+    Vector3 at = Vector3::Lerp(mPrevCamAt, mCamAt, alpha);
+    gluLookAt(eye.x, eye.y, eye.z,
+        at.x, at.y, at.z,
+        0, 1, 0);
+}
@@ -0,0 +1,414 @@
+// Snapshot binário do World: cabeçalho fixo seguido dos arrays do bando e dos
+// obstáculos, cada um alinhado em 64 bytes. Os arrays ficam no arquivo no mesmo
+// formato da memória (SoA, little-endian), então carregar é mapear o arquivo
+// (MAP_PRIVATE, copy-on-write) e os arrays do FlockState adotarem as páginas
+// mapeadas, sem copiar nem interpretar nada. O custo de ler o arquivo vai para
+// o primeiro acesso a cada página, e a escrita copia só a página escrita.
+// Só os obstáculos (poucos) são copiados.
+
+#include "World.h"
+#include "Random.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char kSnapshotMagic[8] = { 'B', 'O', 'I', 'D', 'S', 'N', 'A', 'P' };
+
+// Muda sempre que o layout do arquivo mudar
+static const uint32_t kSnapshotVersion = 3;
+
+static const uint64_t kSnapshotAlignment = 64;
+
+// Valores válidos de World::CameraMode (Tower, Behind, Side)
+static const int32_t kSnapshotCameraModeCount = 3;
+
+// Arrays gravados, na ordem em que aparecem no arquivo
+enum SnapshotArray {
+    SnapshotPositions,
+    SnapshotVelocities,
+    SnapshotYaws,
+    SnapshotPrevYaws,
+    SnapshotPitches,
+    SnapshotRolls,
+    SnapshotSpeeds,
+    SnapshotAnimPhases,
+    SnapshotColors,
+    SnapshotMaxSpeeds,
+    SnapshotFlapSpeeds,
+    SnapshotLodElapsed,
+    SnapshotIds,
+    SnapshotObstacles,
+    SnapshotArrayCount
+};
+
+struct SnapshotHeader {
+    char magic[8];            // "BOIDSNAP"
+    uint32_t version;
+    uint32_t seed;
+    uint64_t boidCount;
+    uint64_t goalIndex;       // Slot do objetivo (boidCount = sem objetivo)
+    uint64_t obstacleCount;
+    int32_t cameraMode;
+    uint32_t fogEnabled;
+    float zoomDist;
+    float camEye[3];
+    float camAt[3];
+    int32_t framesSinceSort;  // Fase da reordenação e do LOD, para a continuação
+    uint32_t lodFrame;        // ser idêntica à execução sem o snapshot
+    uint32_t nextId;          // Próximo id de boid
+    uint64_t frameIndex;      // Passos simulados até o snapshot
+    double simTime;           // Tempo simulado até o snapshot
+    uint64_t randomSeed;      // Estado do Random da thread que gravou: depois do Load os
+    uint64_t randomNextStream; // sorteios continuam de onde pararam, sem repetir números
+    uint32_t randomStream[4];
+    uint64_t fileSize;
+    uint64_t offsets[SnapshotArrayCount]; // Início de cada array no arquivo (múltiplo de 64)
+};
+
+static_assert(std::is_trivially_copyable<SnapshotHeader>::value, "SnapshotHeader é gravado com fwrite");
+static_assert(std::is_trivially_copyable<Vector3>::value && sizeof(Vector3) == 12, "Vector3 é gravado como 3 floats");
+static_assert(std::is_trivially_copyable<Obstacle>::value && sizeof(Obstacle) == 16, "Obstacle é gravado como 4 floats");
+
+// Descrição de cada array: onde está no World e quantos bytes ocupa
+struct SnapshotArrayRef {
+    void* data;
+    uint64_t size;
+};
+
+template <typename Array>
+static SnapshotArrayRef ArrayRef(Array& values) {
+    return { values.data(), values.size() * sizeof(values[0]) };
+}
+
+static uint64_t AlignUp(uint64_t offset) {
+    return (offset + kSnapshotAlignment - 1) & ~(kSnapshotAlignment - 1);
+}
+
+// Todos os arrays do snapshot, na ordem de SnapshotArray
+static void GatherArrays(FlockState& flock, std::vector<Obstacle>& obstacles, SnapshotArrayRef refs[SnapshotArrayCount]) {
+    FlockFrame& frame = flock.Current();
+    refs[SnapshotPositions] = ArrayRef(frame.positions);
+    refs[SnapshotVelocities] = ArrayRef(frame.velocities);
+    refs[SnapshotYaws] = ArrayRef(frame.yaws);
+    refs[SnapshotPrevYaws] = ArrayRef(frame.prevYaws);
+    refs[SnapshotPitches] = ArrayRef(frame.pitches);
+    refs[SnapshotRolls] = ArrayRef(frame.rolls);
+    refs[SnapshotSpeeds] = ArrayRef(frame.speeds);
+    refs[SnapshotAnimPhases] = ArrayRef(frame.animPhases);
+    refs[SnapshotColors] = ArrayRef(flock.colors);
+    refs[SnapshotMaxSpeeds] = ArrayRef(flock.maxSpeeds);
+    refs[SnapshotFlapSpeeds] = ArrayRef(flock.flapSpeeds);
+    refs[SnapshotLodElapsed] = ArrayRef(flock.lodElapsed);
+    refs[SnapshotIds] = ArrayRef(flock.ids);
+    refs[SnapshotObstacles] = ArrayRef(obstacles);
+}
+
+bool World::SaveSnapshot(const char* path) const {
+    // GatherArrays só lê através das referências, mas pede acesso não-const aos vetores
+    World& self = const_cast<World&>(*this);
+
+    SnapshotHeader header = {};
+    memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kSnapshotVersion;
+    header.seed = mSeed;
+    header.boidCount = mFlock.Size();
+    header.goalIndex = mFlock.IsValid(mGoal) ? mFlock.Resolve(mGoal) : mFlock.Size();
+    header.obstacleCount = mObstacles.size();
+    header.cameraMode = static_cast<int32_t>(mCameraMode);
+    header.fogEnabled = mIsFogEnabled ? 1 : 0;
+    header.zoomDist = mZoomDist;
+    header.camEye[0] = mCamEye.x; header.camEye[1] = mCamEye.y; header.camEye[2] = mCamEye.z;
+    header.camAt[0] = mCamAt.x; header.camAt[1] = mCamAt.y; header.camAt[2] = mCamAt.z;
+    header.framesSinceSort = mFramesSinceSort;
+    header.lodFrame = mLodFrame;
+    header.nextId = mFlock.nextId;
+    header.frameIndex = mFrameIndex;
+    header.simTime = mSimTime;
+    Random::State random = Random::GetState();
+    header.randomSeed = random.masterSeed;
+    header.randomNextStream = random.nextStream;
+    memcpy(header.randomStream, random.stream, sizeof(header.randomStream));
+
+    SnapshotArrayRef refs[SnapshotArrayCount];
+    GatherArrays(self.mFlock, self.mObstacles, refs);
+
+    uint64_t offset = AlignUp(sizeof(SnapshotHeader));
+    for (int a = 0; a < SnapshotArrayCount; a++) {
+        header.offsets[a] = offset;
+        offset = AlignUp(offset + refs[a].size);
+    }
+    header.fileSize = offset;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+
+    static const char padding[kSnapshotAlignment] = {};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    uint64_t written = sizeof(header);
+    for (int a = 0; a < SnapshotArrayCount && ok; a++) {
+        ok = fwrite(padding, 1, header.offsets[a] - written, file) == header.offsets[a] - written;
+        ok = ok && (refs[a].size == 0 || fwrite(refs[a].data, 1, refs[a].size, file) == refs[a].size);
+        written = header.offsets[a] + refs[a].size;
+    }
+    ok = ok && fwrite(padding, 1, header.fileSize - written, file) == header.fileSize - written;
+
+    return fclose(file) == 0 && ok;
+}
+
+// Arquivo inteiro acessível como um bloco de bytes. No POSIX é um mmap
+// MAP_PRIVATE com escrita: as páginas são as do page cache até alguém escrever
+// nelas, e a escrita copia só a página tocada, sem chegar ao arquivo. No
+// Windows o arquivo é lido inteiro para a memória.
+class SnapshotFile {
+public:
+    SnapshotFile() : mSize(0) {}
+    ~SnapshotFile() { Close(); }
+
+    bool Open(const char* path) {
+#ifdef _WIN32
+        FILE* file = fopen(path, "rb");
+        if (!file) return false;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        bool ok = size > 0;
+        if (ok) {
+            mSize = static_cast<size_t>(size);
+            mData.reset(new unsigned char[mSize], std::default_delete<unsigned char[]>());
+            ok = fread(mData.get(), 1, mSize, file) == mSize;
+        }
+        fclose(file);
+        if (!ok) Close();
+        return ok;
+#else
+        mFd = open(path, O_RDONLY);
+        if (mFd < 0) return false;
+        struct stat info;
+        if (fstat(mFd, &info) != 0 || info.st_size <= 0) {
+            Close();
+            return false;
+        }
+        mSize = static_cast<size_t>(info.st_size);
+        mData = Map();
+        if (!mData) Close();
+        return mData != nullptr;
+#endif
+    }
+
+    void Close() {
+#ifndef _WIN32
+        if (mFd >= 0) close(mFd);
+        mFd = -1;
+#endif
+        mData.reset();
+        mSize = 0;
+    }
+
+    // Mais uma cópia privada do arquivo inteiro, independente de GetMapping()
+    // (nullptr se falhar). No POSIX é outro mapeamento, sem ler nada agora.
+    std::shared_ptr<unsigned char> MapCopy() const {
+#ifdef _WIN32
+        std::shared_ptr<unsigned char> copy(new unsigned char[mSize], std::default_delete<unsigned char[]>());
+        memcpy(copy.get(), mData.get(), mSize);
+        return copy;
+#else
+        return Map();
+#endif
+    }
+
+    // O mapeamento continua válido depois do Close enquanto alguém guardar o shared_ptr
+    const std::shared_ptr<unsigned char>& GetMapping() const { return mData; }
+    const unsigned char* GetData() const { return mData.get(); }
+    size_t GetSize() const { return mSize; }
+
+private:
+#ifndef _WIN32
+    std::shared_ptr<unsigned char> Map() const {
+        void* data = mmap(nullptr, mSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, mFd, 0);
+        if (data == MAP_FAILED) return nullptr;
+        const size_t size = mSize;
+        return std::shared_ptr<unsigned char>(static_cast<unsigned char*>(data),
+                                              [size](unsigned char* p) { munmap(p, size); });
+    }
+
+    int mFd = -1;
+#endif
+    std::shared_ptr<unsigned char> mData;
+    size_t mSize;
+};
+
+// Bytes por elemento de cada array, na ordem de SnapshotArray
+static const uint64_t kSnapshotElementSizes[SnapshotArrayCount] = {
+    sizeof(Vector3), sizeof(Vector3),
+    sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(float),
+    sizeof(Vector3), sizeof(float), sizeof(float), sizeof(float),
+    sizeof(uint32_t),
+    sizeof(Obstacle)
+};
+
+// Lê e valida o cabeçalho, inclusive se cada array cabe no arquivo
+static bool ReadSnapshotHeader(const SnapshotFile& file, SnapshotHeader& header) {
+    if (file.GetSize() < sizeof(SnapshotHeader)) return false;
+
+    memcpy(&header, file.GetData(), sizeof(header));
+    if (memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+        header.version != kSnapshotVersion ||
+        header.fileSize != file.GetSize() ||
+        header.goalIndex > header.boidCount ||
+        header.cameraMode < 0 || header.cameraMode >= kSnapshotCameraModeCount) {
+        return false;
+    }
+
+    for (int a = 0; a < SnapshotArrayCount; a++) {
+        // Contagens vêm do arquivo: compara pela divisão para o produto não dar a volta
+        uint64_t count = a == SnapshotObstacles ? header.obstacleCount : header.boidCount;
+        if (header.offsets[a] % kSnapshotAlignment != 0 ||
+            header.offsets[a] > header.fileSize ||
+            count > (header.fileSize - header.offsets[a]) / kSnapshotElementSizes[a]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// O array passa a usar as páginas do array do snapshot em mapping
+template <typename T>
+static void AdoptArray(FlockArray<T>& values, const std::shared_ptr<unsigned char>& mapping,
+                       const SnapshotHeader& header, SnapshotArray array) {
+    values.Adopt(reinterpret_cast<T*>(mapping.get() + header.offsets[array]), header.boidCount, mapping);
+}
+
+static void AdoptFrame(FlockFrame& frame, const std::shared_ptr<unsigned char>& mapping, const SnapshotHeader& header) {
+    AdoptArray(frame.positions, mapping, header, SnapshotPositions);
+    AdoptArray(frame.velocities, mapping, header, SnapshotVelocities);
+    AdoptArray(frame.yaws, mapping, header, SnapshotYaws);
+    AdoptArray(frame.prevYaws, mapping, header, SnapshotPrevYaws);
+    AdoptArray(frame.pitches, mapping, header, SnapshotPitches);
+    AdoptArray(frame.rolls, mapping, header, SnapshotRolls);
+    AdoptArray(frame.speeds, mapping, header, SnapshotSpeeds);
+    AdoptArray(frame.animPhases, mapping, header, SnapshotAnimPhases);
+}
+
+bool World::LoadSnapshot(const char* path) {
+    SnapshotFile file;
+    SnapshotHeader header;
+    if (!file.Open(path) || !ReadSnapshotHeader(file, header)) return false;
+    const uint64_t count = header.boidCount;
+
+    // O estado anterior (Next, interpolação do desenho) começa igual ao atual,
+    // mas o passo escreve nele: precisa de páginas próprias, de outro mapeamento
+    std::shared_ptr<unsigned char> previous = file.MapCopy();
+    if (!previous) return false;
+
+    // Descarta o mundo atual
+    mFlock.Resize(0);
+    mBoidPool.Reset();
+    mGoal = BoidHandle();
+
+    // Os arrays do bando adotam as páginas mapeadas (sem copiar); crescer ou
+    // reordenar o bando depois leva cada array para o heap
+    const std::shared_ptr<unsigned char>& mapping = file.GetMapping();
+    AdoptFrame(mFlock.Current(), mapping, header);
+    AdoptFrame(mFlock.Next(), previous, header);
+    AdoptArray(mFlock.colors, mapping, header, SnapshotColors);
+    AdoptArray(mFlock.maxSpeeds, mapping, header, SnapshotMaxSpeeds);
+    AdoptArray(mFlock.flapSpeeds, mapping, header, SnapshotFlapSpeeds);
+    AdoptArray(mFlock.lodElapsed, mapping, header, SnapshotLodElapsed);
+    AdoptArray(mFlock.ids, mapping, header, SnapshotIds);
+
+    // Só handles e slots de Boid vazios: os objetos Boid são criados pelo
+    // GetBoid quando alguém pede (os laços do passo e do desenho usam o slot)
+    mFlock.Resize(count);
+    mGoal = header.goalIndex < count ? mFlock.GetHandle(header.goalIndex) : BoidHandle();
+
+    mObstacles.resize(header.obstacleCount);
+    if (header.obstacleCount > 0) {
+        memcpy(mObstacles.data(), file.GetData() + header.offsets[SnapshotObstacles], header.obstacleCount * sizeof(Obstacle));
+    }
+
+    mSeed = header.seed;
+    mHasSeed = true;
+    Random::State random;
+    random.masterSeed = header.randomSeed;
+    random.nextStream = header.randomNextStream;
+    memcpy(random.stream, header.randomStream, sizeof(random.stream));
+    Random::SetState(random);
+
+    static_assert(static_cast<int32_t>(CameraMode::Side) == kSnapshotCameraModeCount - 1, "atualize kSnapshotCameraModeCount");
+    mCameraMode = static_cast<CameraMode>(header.cameraMode);
+    mIsFogEnabled = header.fogEnabled != 0;
+    mZoomDist = header.zoomDist;
+    mCamEye = Vector3(header.camEye[0], header.camEye[1], header.camEye[2]);
+    mCamAt = Vector3(header.camAt[0], header.camAt[1], header.camAt[2]);
+    mPrevCamEye = mCamEye;
+    mPrevCamAt = mCamAt;
+
+    mFramesSinceSort = header.framesSinceSort;
+    mLodFrame = header.lodFrame;
+    mFlock.nextId = header.nextId;
+    mFrameIndex = header.frameIndex;
+    mSimTime = header.simTime;
+    mNeighborList.Invalidate();
+    RebuildScenery();
+    return true;
+}
+
+size_t World::SpawnFromSnapshot(size_t count, const SpawnDistribution& distribution) {
+    SnapshotFile file;
+    SnapshotHeader header;
+    if (!distribution.snapshotPath || !file.Open(distribution.snapshotPath) || !ReadSnapshotHeader(file, header)) {
+        return 0;
+    }
+
+    // Boids do snapshot dentro da região (o objetivo fica de fora)
+    const Vector3* positions = reinterpret_cast<const Vector3*>(file.GetData() + header.offsets[SnapshotPositions]);
+    const Vector3& min = distribution.min;
+    const Vector3& max = distribution.max;
+    std::vector<uint32_t> sources;
+    for (uint64_t i = 0; i < header.boidCount; i++) {
+        const Vector3& p = positions[i];
+        if (i != header.goalIndex &&
+            p.x >= min.x && p.y >= min.y && p.z >= min.z &&
+            p.x <= max.x && p.y <= max.y && p.z <= max.z) {
+            sources.push_back(static_cast<uint32_t>(i));
+            if (count > 0 && sources.size() == count) break;
+        }
+    }
+    if (sources.empty()) return 0;
+
+    size_t first = GrowFlock(sources.size());
+
+    // Cópia elemento a elemento de cada array do bando; os ids são os novos do GrowFlock
+    mThreadPool.ParallelFor(sources.size(), 4096, [&](size_t begin, size_t end) {
+        SnapshotArrayRef refs[SnapshotArrayCount];
+        GatherArrays(mFlock, mObstacles, refs);
+
+        for (int a = 0; a < SnapshotIds; a++) {
+            const uint64_t size = kSnapshotElementSizes[a];
+            unsigned char* to = static_cast<unsigned char*>(refs[a].data);
+            const unsigned char* from = file.GetData() + header.offsets[a];
+            for (size_t k = begin; k < end; k++) {
+                memcpy(to + (first + k) * size, from + sources[k] * size, size);
+            }
+        }
+
+        FlockFrame& frame = mFlock.Current();
+        FlockFrame& next = mFlock.Next();
+        for (size_t k = begin; k < end; k++) {
+            size_t i = first + k;
+            frame.positions[i] += distribution.offset;
+            mFlock.lodElapsed[i] = 0.0f;
+            next.CopySlot(frame, i);
+        }
+    }, "flock.spawn");
+
+    return sources.size();
+}